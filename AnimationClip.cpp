@@ -0,0 +1,92 @@
+#include "AnimationClip.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+using namespace spic;
+
+std::vector<std::unique_ptr<const AnimationClip>> AnimationClip::registry;
+std::vector<AnimationClip::Handle> AnimationClip::freeHandles;
+
+AnimationClip::AnimationClip(std::string texture, std::vector<AtlasRegion> frames)
+    : texture {std::move(texture)}, frames {std::move(frames)} {
+    if (this->frames.empty()) throw std::invalid_argument("An animation clip needs at least one frame");
+}
+
+AnimationClip::AnimationClip(std::vector<std::shared_ptr<Sprite>> sprites) : sprites {std::move(sprites)} {
+    if (this->sprites.empty()) throw std::invalid_argument("An animation clip needs at least one frame");
+
+    frames.reserve(this->sprites.size());
+    for (const std::shared_ptr<Sprite> &sprite: this->sprites) {
+        const AtlasRegion *region = sprite->Region();
+        frames.push_back(region ? *region : AtlasRegion {0, 0, 0, 1, 1, 0, 0});
+    }
+}
+
+AnimationClip AnimationClip::Slice(const std::string &sheet, int sheetWidth, int sheetHeight, int frameWidth,
+                                   int frameHeight, std::size_t first, std::size_t count) {
+    if (frameWidth <= 0 || frameHeight <= 0 || frameWidth > sheetWidth || frameHeight > sheetHeight) {
+        throw std::invalid_argument("Frames of " + std::to_string(frameWidth) + "x" + std::to_string(frameHeight) +
+                                    " do not fit sheet '" + sheet + "'");
+    }
+
+    const std::size_t columns = sheetWidth / frameWidth;
+    const std::size_t cells = columns * (sheetHeight / frameHeight);
+    if (first >= cells) throw std::invalid_argument("Sheet '" + sheet + "' has no cell " + std::to_string(first));
+    count = std::min(count, cells - first);
+
+    std::vector<AtlasRegion> frames;
+    frames.reserve(count);
+    for (std::size_t cell = first; cell < first + count; ++cell) {
+        const int x = static_cast<int>(cell % columns) * frameWidth;
+        const int y = static_cast<int>(cell / columns) * frameHeight;
+        frames.push_back({0, static_cast<double>(x) / sheetWidth, static_cast<double>(y) / sheetHeight,
+                          static_cast<double>(x + frameWidth) / sheetWidth,
+                          static_cast<double>(y + frameHeight) / sheetHeight, frameWidth, frameHeight});
+    }
+
+    return {sheet, std::move(frames)};
+}
+
+AnimationClip AnimationClip::FromAtlas(const std::vector<std::string> &frames) {
+    std::vector<AtlasRegion> regions;
+    regions.reserve(frames.size());
+
+    for (const std::string &frame: frames) {
+        const AtlasRegion *region = TextureAtlas::Find(frame);
+        if (region == nullptr) throw std::invalid_argument("Frame '" + frame + "' is not in a loaded atlas");
+        if (!regions.empty() && region->page != regions.front().page) {
+            throw std::invalid_argument("Frame '" + frame + "' is on another atlas page than the first frame");
+        }
+        regions.push_back(*region);
+    }
+
+    if (regions.empty()) throw std::invalid_argument("An animation clip needs at least one frame");
+    return {TextureAtlas::PagePath(regions.front().page), std::move(regions)};
+}
+
+AnimationClip::Handle AnimationClip::Register(AnimationClip clip) {
+    auto stored = std::make_unique<const AnimationClip>(std::move(clip));
+    if (freeHandles.empty()) {
+        registry.push_back(std::move(stored));
+        return static_cast<Handle>(registry.size() - 1);
+    }
+
+    const Handle handle = freeHandles.back();
+    freeHandles.pop_back();
+    registry[handle] = std::move(stored);
+    return handle;
+}
+
+void AnimationClip::Release(Handle clip) {
+    if (clip >= registry.size() || !registry[clip]) return;
+
+    registry[clip].reset();
+    freeHandles.push_back(clip);
+}
+
+const AnimationClip &AnimationClip::Get(Handle clip) {
+    if (clip >= registry.size() || !registry[clip]) {
+        throw std::out_of_range("No animation clip is registered under handle " + std::to_string(clip));
+    }
+    return *registry[clip];
+}
@@ -0,0 +1,113 @@
+#ifndef ANIMATIONCLIP_H_
+#define ANIMATIONCLIP_H_
+
+#include "Sprite.hpp"
+#include "TextureAtlas.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief A sequence of frames, shared by all Animators playing it.
+     * @details A clip is one texture, usually a sprite sheet, plus a rectangle of it per frame,
+     *          so an animated object needs a single Sprite whatever the number of frames.
+     *          Clips are registered once and then referred to by a small handle; Animators only
+     *          keep the index of their current frame. Flipping is state of the animator, so the
+     *          frames themselves are never modified while playing.
+     */
+    class AnimationClip {
+    public:
+        using Handle = std::uint32_t;
+
+        /**
+         * @brief Constructor.
+         * @param texture The image all frames are taken from.
+         * @param frames The frames, as regions of the texture.
+         * @exception A std::invalid_argument is thrown when there are no frames.
+         */
+        AnimationClip(std::string texture, std::vector<AtlasRegion> frames);
+
+        /**
+         * @brief Constructor for a clip of separate Sprites, as Animators were built before clips
+         *        existed. Frames then take their texture from their own Sprite.
+         * @exception A std::invalid_argument is thrown when there are no sprites.
+         */
+        explicit AnimationClip(std::vector<std::shared_ptr<Sprite>> sprites);
+
+        /**
+         * @brief Slice a sprite sheet into a grid of equally sized frames, taken row by row.
+         * @param sheet The path of the sheet image.
+         * @param sheetWidth The width of the sheet in pixels.
+         * @param sheetHeight The height of the sheet in pixels.
+         * @param frameWidth The width of a frame in pixels.
+         * @param frameHeight The height of a frame in pixels.
+         * @param first The index of the first cell to use.
+         * @param count The number of cells to use, by default all from first on.
+         * @exception A std::invalid_argument is thrown when the cells do not fit the sheet.
+         */
+        static AnimationClip Slice(const std::string &sheet, int sheetWidth, int sheetHeight, int frameWidth,
+                                   int frameHeight, std::size_t first = 0,
+                                   std::size_t count = std::numeric_limits<std::size_t>::max());
+
+        /**
+         * @brief Build a clip from images packed by AtlasPacker, using the regions TextureAtlas
+         *        has loaded for them.
+         * @param frames The sprite paths of the frames, in playing order.
+         * @exception A std::invalid_argument is thrown when a frame is not in a loaded atlas, or
+         *            when the frames are spread over several pages.
+         */
+        static AnimationClip FromAtlas(const std::vector<std::string> &frames);
+
+        /**
+         * @brief Store a clip for sharing.
+         * @return The handle to refer to the clip by.
+         */
+        static Handle Register(AnimationClip clip);
+
+        /**
+         * @brief Drop a registered clip. Its handle may be handed out again by a later Register.
+         */
+        static void Release(Handle clip);
+
+        /**
+         * @brief A registered clip. The reference stays valid until the clip is released.
+         * @exception A std::out_of_range is thrown when no clip is registered under the handle.
+         */
+        static const AnimationClip &Get(Handle clip);
+
+        [[nodiscard]] std::size_t FrameCount() const { return frames.size(); }
+
+        /**
+         * @brief The part of Texture() showing a frame.
+         */
+        [[nodiscard]] const AtlasRegion &Frame(std::size_t index) const { return frames[index]; }
+
+        /**
+         * @brief The image the frames are taken from; empty for a clip of separate Sprites.
+         */
+        [[nodiscard]] const std::string &Texture() const { return texture; }
+
+        /**
+         * @brief The Sprite of a frame for a clip of separate Sprites, nullptr otherwise.
+         */
+        [[nodiscard]] std::shared_ptr<Sprite> FrameSprite(std::size_t index) const {
+            return sprites.empty() ? nullptr : sprites[index];
+        }
+
+    private:
+        std::string texture;
+        std::vector<AtlasRegion> frames;
+        std::vector<std::shared_ptr<Sprite>> sprites;
+
+        static std::vector<std::unique_ptr<const AnimationClip>> registry;
+        static std::vector<Handle> freeHandles;
+    };
+
+}
+
+#endif // ANIMATIONCLIP_H_
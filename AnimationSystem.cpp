@@ -0,0 +1,184 @@
+#include "AnimationSystem.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPIC_ANIMATION_SSE2
+#endif
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief A playing speed as stored; frames only ever advance, so it must be positive.
+     */
+    float CheckedFps(double fps) {
+        // Also catches NaN.
+        if (!(fps > 0)) throw std::invalid_argument("The frames per second must be greater than 0");
+        return static_cast<float>(fps);
+    }
+
+}
+
+AnimationSystem::Handle AnimationSystem::Add(AnimationClip::Handle clip, double newFps) {
+    const float checkedFps = CheckedFps(newFps);
+    Handle animator;
+    if (freeHandles.empty()) {
+        animator = static_cast<Handle>(slots.size());
+        slots.push_back(0);
+    } else {
+        animator = freeHandles.back();
+        freeHandles.pop_back();
+    }
+
+    slots[animator] = static_cast<std::uint32_t>(owners.size());
+    owners.push_back(animator);
+    rate.push_back(0);
+    progress.push_back(0);
+    fps.push_back(checkedFps);
+    frame.push_back(0);
+    frameCount.push_back(static_cast<std::uint32_t>(AnimationClip::Get(clip).FrameCount()));
+    flags.push_back(0);
+    clips.push_back(clip);
+    steps.push_back(0);
+    return animator;
+}
+
+void AnimationSystem::Remove(Handle animator) {
+    const std::uint32_t index = slots[animator];
+    const std::size_t last = owners.size() - 1;
+
+    // Move the last animator into the hole.
+    rate[index] = rate[last];
+    progress[index] = progress[last];
+    fps[index] = fps[last];
+    frame[index] = frame[last];
+    frameCount[index] = frameCount[last];
+    flags[index] = flags[last];
+    clips[index] = clips[last];
+    owners[index] = owners[last];
+    slots[owners[index]] = index;
+
+    rate.pop_back();
+    progress.pop_back();
+    fps.pop_back();
+    frame.pop_back();
+    frameCount.pop_back();
+    flags.pop_back();
+    clips.pop_back();
+    owners.pop_back();
+    steps.pop_back();
+    freeHandles.push_back(animator);
+}
+
+void AnimationSystem::Play(Handle animator, bool loop) {
+    const std::uint32_t index = slots[animator];
+    flags[index] = static_cast<std::uint8_t>((flags[index] & ~looping) | playing | (loop ? looping : 0));
+    rate[index] = fps[index];
+}
+
+void AnimationSystem::Stop(Handle animator) {
+    const std::uint32_t index = slots[animator];
+    flags[index] &= ~playing;
+    rate[index] = 0;
+}
+
+bool AnimationSystem::Playing(Handle animator) const {
+    return flags[slots[animator]] & playing;
+}
+
+void AnimationSystem::Fps(Handle animator, double newFps) {
+    const std::uint32_t index = slots[animator];
+    fps[index] = CheckedFps(newFps);
+    if (flags[index] & playing) rate[index] = fps[index];
+}
+
+double AnimationSystem::Fps(Handle animator) const {
+    return fps[slots[animator]];
+}
+
+void AnimationSystem::FlipX(Handle animator, bool value) {
+    SetFlag(animator, flipX, value);
+}
+
+bool AnimationSystem::FlipX(Handle animator) const {
+    return flags[slots[animator]] & flipX;
+}
+
+void AnimationSystem::FlipY(Handle animator, bool value) {
+    SetFlag(animator, flipY, value);
+}
+
+bool AnimationSystem::FlipY(Handle animator) const {
+    return flags[slots[animator]] & flipY;
+}
+
+void AnimationSystem::Frame(Handle animator, std::size_t newFrame) {
+    const std::uint32_t index = slots[animator];
+    frame[index] = static_cast<std::uint32_t>(std::min<std::size_t>(newFrame, frameCount[index] - 1));
+    progress[index] = 0;
+}
+
+std::size_t AnimationSystem::Frame(Handle animator) const {
+    return frame[slots[animator]];
+}
+
+void AnimationSystem::Next(Handle animator) {
+    const std::uint32_t index = slots[animator];
+    progress[index] = 0;
+    Advance(index, 1);
+}
+
+void AnimationSystem::Update(double deltaTime) {
+    const std::size_t count = owners.size();
+    // Time only moves forward; a negative step would make the frame counts below wrap around.
+    const float delta = deltaTime > 0 ? static_cast<float>(deltaTime) : 0.0f;
+    std::size_t i = 0;
+
+    // progress += delta * rate; the whole part is the number of frames to advance.
+#ifdef SPIC_ANIMATION_SSE2
+    const __m128 deltas = _mm_set1_ps(delta);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 advanced = _mm_add_ps(_mm_loadu_ps(progress.data() + i),
+                                           _mm_mul_ps(deltas, _mm_loadu_ps(rate.data() + i)));
+        const __m128i whole = _mm_cvttps_epi32(advanced);
+        _mm_storeu_ps(progress.data() + i, _mm_sub_ps(advanced, _mm_cvtepi32_ps(whole)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(steps.data() + i), whole);
+    }
+#endif
+    for (; i < count; ++i) {
+        const float advanced = progress[i] + delta * rate[i];
+        steps[i] = static_cast<std::uint32_t>(advanced);
+        progress[i] = advanced - static_cast<float>(steps[i]);
+    }
+
+    for (i = 0; i < count; ++i) {
+        if (steps[i] != 0) Advance(i, steps[i]);
+    }
+}
+
+AnimationSystem &AnimationSystem::Shared() {
+    static AnimationSystem shared;
+    return shared;
+}
+
+void AnimationSystem::Advance(std::size_t index, std::uint32_t count) {
+    const std::uint32_t next = frame[index] + count;
+    if (next < frameCount[index]) {
+        frame[index] = next;
+    } else if (flags[index] & looping) {
+        frame[index] = next % frameCount[index];
+    } else {
+        frame[index] = frameCount[index] - 1;
+        flags[index] &= ~playing;
+        rate[index] = 0;
+        progress[index] = 0;
+    }
+}
+
+void AnimationSystem::SetFlag(Handle animator, Flags flag, bool value) {
+    const std::uint32_t index = slots[animator];
+    flags[index] = static_cast<std::uint8_t>(value ? flags[index] | flag : flags[index] & ~flag);
+}
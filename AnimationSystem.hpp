@@ -0,0 +1,146 @@
+#ifndef ANIMATIONSYSTEM_H_
+#define ANIMATIONSYSTEM_H_
+
+#include "AnimationClip.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Advances all animators together, once per tick.
+     * @details The state of every animator (playing speed, progress towards the next frame,
+     *          current frame, looping and flip flags) is kept in parallel arrays rather than in
+     *          the Animator components. Update makes one pass over the speed and progress arrays,
+     *          which uses SSE2 when the compiler targets it, and only touches the frame of the
+     *          animators that actually move on to another frame. Removing an animator moves the
+     *          last one into its place, so the arrays stay dense; handles remain valid.
+     */
+    class AnimationSystem {
+    public:
+        using Handle = std::uint32_t;
+
+        /**
+         * @brief Add a stopped animator at the first frame of a clip.
+         * @param clip A registered clip, which must stay registered while the animator exists.
+         * @param fps The playing speed in frames per second.
+         * @return A handle for controlling the animator.
+         * @exception A std::invalid_argument is thrown when fps is not greater than 0.
+         */
+        Handle Add(AnimationClip::Handle clip, double fps);
+
+        /**
+         * @brief Remove an animator. Its handle may be handed out again by a later Add.
+         */
+        void Remove(Handle animator);
+
+        /**
+         * @brief Start playing from the current frame.
+         * @param looping If true, start again at the first frame after the last one; otherwise
+         *        stop at the last frame.
+         */
+        void Play(Handle animator, bool looping);
+
+        /**
+         * @brief Stop playing, keeping the current frame.
+         */
+        void Stop(Handle animator);
+
+        [[nodiscard]] bool Playing(Handle animator) const;
+
+        /**
+         * @brief Set the playing speed in frames per second.
+         * @exception A std::invalid_argument is thrown when fps is not greater than 0.
+         */
+        void Fps(Handle animator, double fps);
+
+        [[nodiscard]] double Fps(Handle animator) const;
+
+        void FlipX(Handle animator, bool flipX);
+
+        [[nodiscard]] bool FlipX(Handle animator) const;
+
+        void FlipY(Handle animator, bool flipY);
+
+        [[nodiscard]] bool FlipY(Handle animator) const;
+
+        /**
+         * @brief Jump to a frame, clamped to the clip.
+         */
+        void Frame(Handle animator, std::size_t frame);
+
+        /**
+         * @brief The index of the current frame in the clip.
+         */
+        [[nodiscard]] std::size_t Frame(Handle animator) const;
+
+        /**
+         * @brief Move to the next frame now, regardless of time, as if it were due.
+         */
+        void Next(Handle animator);
+
+        [[nodiscard]] const AnimationClip &Clip(Handle animator) const { return AnimationClip::Get(clips[slots[animator]]); }
+
+        /**
+         * @brief The part of the clip's texture showing the current frame.
+         */
+        [[nodiscard]] const AtlasRegion &Region(Handle animator) const { return Clip(animator).Frame(Frame(animator)); }
+
+        /**
+         * @brief Advance all playing animators.
+         * @param deltaTime The time since the last update, in seconds; a negative time counts as 0.
+         */
+        void Update(double deltaTime);
+
+        /**
+         * @brief The number of animators.
+         */
+        [[nodiscard]] std::size_t Size() const { return owners.size(); }
+
+        /**
+         * @brief The system Animator components register with; the engine updates it once per
+         *        frame with Time::DeltaTime().
+         */
+        static AnimationSystem &Shared();
+
+    private:
+        enum Flags : std::uint8_t {
+            playing = 1,
+            looping = 2,
+            flipX = 4,
+            flipY = 8
+        };
+
+        void Advance(std::size_t index, std::uint32_t steps);
+
+        void SetFlag(Handle animator, Flags flag, bool value);
+
+        /**
+         * @brief Per animator, in dense order. rate is fps while playing and 0 while stopped;
+         *        progress is the fraction of the current frame that has passed.
+         */
+        std::vector<float> rate;
+        std::vector<float> progress;
+        std::vector<float> fps;
+        std::vector<std::uint32_t> frame;
+        std::vector<std::uint32_t> frameCount;
+        std::vector<std::uint8_t> flags;
+        std::vector<AnimationClip::Handle> clips;
+
+        /**
+         * @brief Whole frames passed during the current Update, per animator.
+         */
+        std::vector<std::uint32_t> steps;
+
+        /**
+         * @brief Handle to dense index, dense index to handle, and handles free for reuse.
+         */
+        std::vector<std::uint32_t> slots;
+        std::vector<Handle> owners;
+        std::vector<Handle> freeHandles;
+    };
+
+}
+
+#endif // ANIMATIONSYSTEM_H_
@@ -0,0 +1,72 @@
+#include "Animator.hpp"
+#include <stdexcept>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief Register the clip of an animator only once its fps is known to be accepted, so a
+     *        rejected animator does not leave its clip registered.
+     */
+    AnimationClip::Handle RegisterOwnClip(double fps, std::vector<std::shared_ptr<Sprite>> sprites) {
+        if (!(fps > 0)) throw std::invalid_argument("The frames per second must be greater than 0");
+        return AnimationClip::Register(AnimationClip {std::move(sprites)});
+    }
+
+}
+
+Animator::Animator(double fps, std::vector<std::shared_ptr<Sprite>> sprites)
+    : Animator(fps, RegisterOwnClip(fps, std::move(sprites))) {
+    ownsClip = true;
+}
+
+Animator::Animator(double fps, AnimationClip::Handle clip)
+    : clip {clip}, handle {AnimationSystem::Shared().Add(clip, fps)} {}
+
+Animator::~Animator() {
+    AnimationSystem::Shared().Remove(handle);
+    if (ownsClip) AnimationClip::Release(clip);
+}
+
+void Animator::Play(bool looping) {
+    AnimationSystem::Shared().Play(handle, looping);
+}
+
+void Animator::Stop() {
+    AnimationSystem::Shared().Stop(handle);
+}
+
+void Animator::Fps(double fps) {
+    AnimationSystem::Shared().Fps(handle, fps);
+}
+
+double Animator::Fps() const {
+    return AnimationSystem::Shared().Fps(handle);
+}
+
+std::shared_ptr<Sprite> Animator::GetSprite() {
+    // Time is advanced for all animators at once by AnimationSystem::Update.
+    return CurrentSprite();
+}
+
+std::shared_ptr<Sprite> Animator::NextSprite() {
+    AnimationSystem::Shared().Next(handle);
+    return CurrentSprite();
+}
+
+std::shared_ptr<Sprite> Animator::CurrentSprite() {
+    return AnimationClip::Get(clip).FrameSprite(AnimationSystem::Shared().Frame(handle));
+}
+
+void Animator::FlipX(bool newFlipX) {
+    AnimationSystem::Shared().FlipX(handle, newFlipX);
+}
+
+void Animator::FlipY(bool newFlipY) {
+    AnimationSystem::Shared().FlipY(handle, newFlipY);
+}
+
+const AtlasRegion &Animator::CurrentRegion() const {
+    return AnimationSystem::Shared().Region(handle);
+}
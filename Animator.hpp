@@ -2,6 +2,7 @@
 #define ANIMATOR_H_
 
 #include <vector>
+#include "AnimationSystem.hpp"
 #include "Component.hpp"
 #include "Sprite.hpp"
 #include <memory>
@@ -10,11 +11,36 @@ namespace spic {
 
     /**
      * @brief A component which can play animated sequences of sprites.
+     * @details The animator itself only holds a handle: its playing state lives in
+     *          AnimationSystem::Shared(), which advances all animators in one pass per frame, and its
+     *          frames belong to an AnimationClip shared with other animators. The GameObject's
+     *          Sprite refers to the clip's texture, and is drawn with the current frame's region.
      */
     class Animator : public Component {
     public:
-        Animator(double fps, std::vector<std::shared_ptr<Sprite>> sprites)
-                : Component(), fps(fps), _looping(true), sprites(std::move(sprites)), secondsSinceLastFrame(0) {};
+        /**
+         * @brief Constructor for an animation of separate Sprites. The sprites are registered as
+         *        a clip of this animator's own, released along with it.
+         * @exception A std::invalid_argument is thrown when fps is not greater than 0.
+         */
+        Animator(double fps, std::vector<std::shared_ptr<Sprite>> sprites);
+
+        /**
+         * @brief Constructor, registering the animator with AnimationSystem::Shared().
+         * @param fps The playing speed in frames per second.
+         * @param clip A registered clip, usually shared with other animators.
+         * @exception A std::invalid_argument is thrown when fps is not greater than 0.
+         */
+        Animator(double fps, AnimationClip::Handle clip);
+
+        /**
+         * @brief Destructor, unregistering the animator from the AnimationSystem.
+         */
+        ~Animator();
+
+        Animator(const Animator &other) = delete;
+
+        Animator &operator=(const Animator &other) = delete;
 
         /**
          * @brief Start playing the image sequence.
@@ -53,43 +79,40 @@ namespace spic {
 
         /**
         * @brief Get the current sprite from the animation.\n
-        * Can be used to manipulate the currentSprite (FlipX,FlipY etc.)
-        * @return The current sprite
+        * The sprite belongs to the shared clip; flip the animator instead of the sprite.
+        * @return The current sprite, or nullptr if the clip is a sliced texture (see CurrentRegion)
         * @spicapi
         */
         std::shared_ptr<spic::Sprite> CurrentSprite();
 
         /**
-        * @brief Change FlipX of all sprites in the animator
+        * @brief Mirror the animation horizontally. This is state of the animator, combined
+        *        with the frame's own flip when drawing; the frames are not modified.
         * @spicapi
         */
         void FlipX(bool newFlipX);
 
         /**
-        * @brief Change FlipY of all sprites in the animator
+        * @brief Mirror the animation vertically. This is state of the animator, combined
+        *        with the frame's own flip when drawing; the frames are not modified.
         * @spicapi
         */
         void FlipY(bool newFlipY);
-    private:
-        /**
-        * @brief reset the current frame if the last sprite is surpassed.\n
-        * This function would start with the first frame if looping is true, or will stop at the last frame if looping is false.
-        * @return The sprite that must be showed, or nullpointer if the animation starts over.
-        * @spicapi
-        */
-        std::shared_ptr<spic::Sprite> resetCurrentFrame();
 
         /**
-         * @brief frames per second (playing speed)
-         * @spicapi
+         * @brief The part of the clip's texture showing the current frame.
          */
-        double fps;
-        double secondsSinceLastFrame;
-        bool isPlaying{};
-        bool _looping;
-        size_t currentFrame{};
+        [[nodiscard]] const AtlasRegion &CurrentRegion() const;
 
-        std::vector<std::shared_ptr<Sprite>> sprites{};
+        [[nodiscard]] AnimationSystem::Handle Handle() const { return handle; }
+    private:
+        AnimationClip::Handle clip;
+        AnimationSystem::Handle handle;
+
+        /**
+         * @brief Whether the clip was registered by this animator, and is released with it.
+         */
+        bool ownsClip {false};
     };
 
 }
@@ -0,0 +1,130 @@
+#include "AtlasPacker.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using namespace spic;
+
+AtlasPacker::AtlasPacker(int pageWidth, int pageHeight, int padding)
+    : pageWidth {pageWidth}, pageHeight {pageHeight}, padding {padding} {}
+
+std::vector<AtlasPlacement> AtlasPacker::Pack(const std::vector<AtlasInput> &inputs) {
+    pages.clear();
+
+    // Placing the largest images first leaves the least unusable space.
+    std::vector<std::size_t> order(inputs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return std::max(inputs[a].width, inputs[a].height) > std::max(inputs[b].width, inputs[b].height);
+    });
+
+    std::vector<AtlasPlacement> placements(inputs.size());
+    for (std::size_t index: order) {
+        const AtlasInput &input = inputs[index];
+        // Padding is added on the right and bottom; the page edges need none.
+        const int width = input.width + padding;
+        const int height = input.height + padding;
+        if (input.width > pageWidth || input.height > pageHeight) {
+            throw std::invalid_argument("Image '" + input.name + "' is larger than an atlas page");
+        }
+
+        int x = 0;
+        int y = 0;
+        std::size_t page = 0;
+        while (page < pages.size() && !Place(pages[page], width, height, x, y)) ++page;
+
+        if (page == pages.size()) {
+            pages.push_back({{0, 0, pageWidth + padding, pageHeight + padding}});
+            Place(pages[page], width, height, x, y);
+        }
+
+        Split(pages[page], {x, y, width, height});
+        Prune(pages[page]);
+        placements[index] = {input.name, page, x, y, input.width, input.height};
+    }
+
+    return placements;
+}
+
+void AtlasPacker::WriteTable(std::ostream &out, const std::vector<std::string> &pagePaths,
+                             const std::vector<AtlasPlacement> &placements) const {
+    for (std::size_t page = 0; page < pagePaths.size(); ++page) {
+        out << "page\t" << page << '\t' << pagePaths[page] << '\t' << pageWidth << '\t' << pageHeight << '\n';
+    }
+    for (const AtlasPlacement &placement: placements) {
+        out << "sprite\t" << placement.name << '\t' << placement.page << '\t' << placement.x << '\t'
+            << placement.y << '\t' << placement.width << '\t' << placement.height << '\n';
+    }
+}
+
+bool AtlasPacker::Place(std::vector<FreeRect> &freeRects, int width, int height, int &x, int &y) const {
+    int bestShortSide = std::numeric_limits<int>::max();
+    int bestLongSide = std::numeric_limits<int>::max();
+
+    for (const FreeRect &free: freeRects) {
+        if (free.width < width || free.height < height) continue;
+
+        const int leftoverX = free.width - width;
+        const int leftoverY = free.height - height;
+        const int shortSide = std::min(leftoverX, leftoverY);
+        const int longSide = std::max(leftoverX, leftoverY);
+
+        if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+            bestShortSide = shortSide;
+            bestLongSide = longSide;
+            x = free.x;
+            y = free.y;
+        }
+    }
+
+    return bestShortSide != std::numeric_limits<int>::max();
+}
+
+void AtlasPacker::Split(std::vector<FreeRect> &freeRects, const FreeRect &used) {
+    const std::size_t count = freeRects.size();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const FreeRect free = freeRects[i];
+        if (used.x >= free.x + free.width || used.x + used.width <= free.x ||
+            used.y >= free.y + free.height || used.y + used.height <= free.y) {
+            continue;
+        }
+
+        // Replace the intersected rectangle by the up to four maximal rectangles around used.
+        if (used.x > free.x) freeRects.push_back({free.x, free.y, used.x - free.x, free.height});
+        if (used.x + used.width < free.x + free.width) {
+            freeRects.push_back({used.x + used.width, free.y, free.x + free.width - used.x - used.width, free.height});
+        }
+        if (used.y > free.y) freeRects.push_back({free.x, free.y, free.width, used.y - free.y});
+        if (used.y + used.height < free.y + free.height) {
+            freeRects.push_back({free.x, used.y + used.height, free.width,
+                                 free.y + free.height - used.y - used.height});
+        }
+        freeRects[i].width = 0;
+    }
+
+    freeRects.erase(std::remove_if(freeRects.begin(), freeRects.end(),
+                                   [](const FreeRect &free) { return free.width == 0; }), freeRects.end());
+}
+
+void AtlasPacker::Prune(std::vector<FreeRect> &freeRects) {
+    auto contains = [](const FreeRect &outer, const FreeRect &inner) {
+        return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width &&
+               inner.y + inner.height <= outer.y + outer.height;
+    };
+
+    for (std::size_t i = 0; i < freeRects.size(); ++i) {
+        for (std::size_t j = i + 1; j < freeRects.size(); ++j) {
+            if (contains(freeRects[j], freeRects[i])) {
+                freeRects.erase(freeRects.begin() + static_cast<std::ptrdiff_t>(i));
+                --i;
+                break;
+            }
+            if (contains(freeRects[i], freeRects[j])) {
+                freeRects.erase(freeRects.begin() + static_cast<std::ptrdiff_t>(j));
+                --j;
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef ATLASPACKER_H_
+#define ATLASPACKER_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief An image to be packed into an atlas.
+     */
+    struct AtlasInput {
+        /**
+         * @brief The name sprites use to refer to the image, i.e. their SpriteSrc.
+         */
+        std::string name;
+        int width;
+        int height;
+    };
+
+    /**
+     * @brief Where the packer put an image.
+     */
+    struct AtlasPlacement {
+        std::string name;
+        std::size_t page;
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    /**
+     * @brief Packs many small images into a few large atlas pages, for use at build time.
+     * @details Uses the MaxRects algorithm with the best-short-side-fit heuristic: the packer
+     *          keeps the maximal free rectangles of every page and places each image, largest
+     *          first, where it leaves the least space along its shorter side. The resulting
+     *          layout is written as the lookup table TextureAtlas reads at runtime. The
+     *          tools/AtlasPack.cpp driver also copies the images into the page images.
+     */
+    class AtlasPacker {
+    public:
+        /**
+         * @brief Constructor.
+         * @param pageWidth The width of every atlas page in pixels.
+         * @param pageHeight The height of every atlas page in pixels.
+         * @param padding Empty pixels kept between images, against bleeding when filtering.
+         */
+        AtlasPacker(int pageWidth, int pageHeight, int padding = 1);
+
+        /**
+         * @brief Pack images, opening new pages when the current ones are full.
+         * @param inputs The images to pack.
+         * @return One placement per input, in the order of inputs.
+         * @exception A std::invalid_argument is thrown when an image does not fit on an empty page.
+         */
+        std::vector<AtlasPlacement> Pack(const std::vector<AtlasInput> &inputs);
+
+        /**
+         * @brief The number of pages used by the last Pack.
+         */
+        [[nodiscard]] std::size_t PageCount() const { return pages.size(); }
+
+        /**
+         * @brief Write the lookup table for a packed layout.
+         * @param out The stream to write to.
+         * @param pagePaths The image file of every page, PageCount() entries.
+         * @param placements The result of Pack.
+         */
+        void WriteTable(std::ostream &out, const std::vector<std::string> &pagePaths,
+                        const std::vector<AtlasPlacement> &placements) const;
+
+    private:
+        struct FreeRect {
+            int x, y, width, height;
+        };
+
+        bool Place(std::vector<FreeRect> &freeRects, int width, int height, int &x, int &y) const;
+
+        static void Split(std::vector<FreeRect> &freeRects, const FreeRect &used);
+
+        static void Prune(std::vector<FreeRect> &freeRects);
+
+        int pageWidth;
+        int pageHeight;
+        int padding;
+
+        /**
+         * @brief The free rectangles of every page.
+         */
+        std::vector<std::vector<FreeRect>> pages;
+    };
+
+}
+
+#endif // ATLASPACKER_H_
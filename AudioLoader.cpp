@@ -0,0 +1,122 @@
+#include "AudioLoader.hpp"
+#include "AudioSource.hpp"
+#include "JobSystem.hpp"
+#include "MappedFile.hpp"
+#include "Scene.hpp"
+#include "WavFormat.hpp"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+
+using namespace spic;
+
+std::atomic<std::size_t> AudioLoader::streamThreshold {std::size_t {1} << 20};
+std::atomic<std::size_t> AudioLoader::liveBytes {0};
+std::atomic<std::size_t> AudioLoader::peakBytes {0};
+
+std::shared_ptr<AudioSamples> AudioLoader::Decode(const std::string &path) {
+    const MappedFile file {path};
+    const WavFormat format = WavFormat::Parse(file.Data(), file.Size(), path);
+    const std::size_t frames = format.Frames();
+
+    const std::size_t bytes = frames * format.channels * sizeof(float);
+    const std::size_t live = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+    // The deleter keeps LiveBytes in step with the clips that are still around.
+    std::shared_ptr<AudioSamples> clip {new AudioSamples {format.sampleRate, format.channels, {}},
+                                        [bytes](AudioSamples *samples) {
+                                            liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+                                            delete samples;
+                                        }};
+    clip->samples.resize(frames * format.channels);
+    format.Decode(file.Data() + format.dataOffset, frames, clip->samples.data());
+    return clip;
+}
+
+void AudioLoader::Register(ResourceCache &cache) {
+    cache.Loader(ResourceType::audio, [](const std::string &path, std::size_t &bytes) -> std::shared_ptr<void> {
+        try {
+            std::shared_ptr<AudioSamples> clip = Decode(path);
+            bytes = clip->samples.size() * sizeof(float);
+            return clip;
+        } catch (const std::runtime_error &) {
+            return nullptr;
+        }
+    });
+}
+
+bool AudioLoader::Streams(const std::string &path) {
+    try {
+        const MappedFile file {path};
+        const WavFormat format = WavFormat::Parse(file.Data(), file.Size(), path);
+        return format.Frames() * format.channels * sizeof(float) > StreamThreshold();
+    } catch (const std::runtime_error &) {
+        return false;
+    }
+}
+
+void AudioLoader::StreamThreshold(std::size_t bytes) {
+    streamThreshold.store(bytes, std::memory_order_relaxed);
+}
+
+std::size_t AudioLoader::StreamThreshold() {
+    return streamThreshold.load(std::memory_order_relaxed);
+}
+
+std::vector<std::string> AudioLoader::PlayOnAwakeClips(const Scene &scene) {
+    std::vector<std::string> paths;
+    for (const std::shared_ptr<GameObject> &object: scene.contents) {
+        for (const std::shared_ptr<AudioSource> &source: object->GetComponents<AudioSource>()) {
+            if (source->PlayOnAwake()) paths.push_back(source->AudioClip());
+        }
+    }
+
+    std::sort(paths.begin(), paths.end());
+    paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+    return paths;
+}
+
+std::future<PreloadReport> AudioLoader::Preload(ResourceCache &cache, std::vector<std::string> paths,
+                                                unsigned int threads) {
+    return std::async(std::launch::async, [&cache, paths = std::move(paths), threads] {
+        const auto start = std::chrono::steady_clock::now();
+        PreloadReport report {};
+        std::mutex mutex;
+        std::atomic<std::size_t> next {0};
+
+        auto work = [&] {
+            for (std::size_t i = next++; i < paths.size(); i = next++) {
+                // Streamed clips are only opened when they start playing.
+                if (Streams(paths[i])) {
+                    std::lock_guard<std::mutex> lock {mutex};
+                    ++report.streamed;
+                    continue;
+                }
+
+                std::shared_ptr<AudioSamples> clip = cache.Get<AudioSamples>(ResourceType::audio, paths[i]);
+                std::lock_guard<std::mutex> lock {mutex};
+                if (clip == nullptr) {
+                    ++report.failed;
+                } else {
+                    report.bytes += clip->samples.size() * sizeof(float);
+                    report.clips.push_back(std::move(clip));
+                }
+            }
+        };
+
+        // One part per thread, each taking clips until none are left.
+        JobSystem &jobs = JobSystem::Shared();
+        const std::size_t parts = std::min<std::size_t>(std::min(std::max(threads, 1u), jobs.Threads()),
+                                                        paths.size());
+        jobs.ParallelFor(parts, 1, [&](std::size_t first, std::size_t last) {
+            for (std::size_t part = first; part < last; ++part) work();
+        });
+
+        report.peakBytes = PeakBytes();
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    });
+}
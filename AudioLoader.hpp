@@ -0,0 +1,124 @@
+#ifndef AUDIOLOADER_H_
+#define AUDIOLOADER_H_
+
+#include "AudioMixer.hpp"
+#include "ResourceCache.hpp"
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace spic {
+
+    class Scene;
+
+    /**
+     * @brief The outcome of AudioLoader::Preload.
+     */
+    struct PreloadReport {
+        /**
+         * @brief The decoded clips, kept alive for as long as the report is.
+         */
+        std::vector<std::shared_ptr<AudioSamples>> clips;
+
+        /**
+         * @brief Clips left to be streamed because they are longer than the stream threshold.
+         */
+        std::size_t streamed;
+
+        /**
+         * @brief Clips that could not be loaded.
+         */
+        std::size_t failed;
+
+        /**
+         * @brief The memory size of the decoded clips.
+         */
+        std::size_t bytes;
+
+        /**
+         * @brief The highest memory size of all decoded clips alive at once, see AudioLoader::PeakBytes.
+         */
+        std::size_t peakBytes;
+
+        /**
+         * @brief How long preloading took.
+         */
+        double seconds;
+    };
+
+    /**
+     * @brief Decodes audio files for the ResourceCache, and decides which clips are streamed.
+     * @details Clips are read through a MappedFile. Short clips are decoded once into
+     *          AudioSamples and shared through the cache; clips that would take more memory than
+     *          StreamThreshold decoded, such as music, are played through an AudioStream instead.
+     *          Supports WAV files with PCM or float samples.
+     */
+    class AudioLoader {
+    public:
+        /**
+         * @brief Decode a whole file.
+         * @exception A std::runtime_error is thrown when the file cannot be read or is not a
+         *            supported format.
+         */
+        static std::shared_ptr<AudioSamples> Decode(const std::string &path);
+
+        /**
+         * @brief Register Decode as the loader of ResourceType::audio.
+         */
+        static void Register(ResourceCache &cache);
+
+        /**
+         * @brief Whether a file should be played through an AudioStream because it is longer
+         *        than the stream threshold. Only reads the file's header; false when it cannot be read.
+         */
+        static bool Streams(const std::string &path);
+
+        /**
+         * @brief Set the decoded size in bytes above which clips are streamed; 1 MiB by default.
+         */
+        static void StreamThreshold(std::size_t bytes);
+
+        [[nodiscard]] static std::size_t StreamThreshold();
+
+        /**
+         * @brief The clips of all AudioSource components in a scene that play on awake, each
+         *        path once.
+         */
+        static std::vector<std::string> PlayOnAwakeClips(const Scene &scene);
+
+        /**
+         * @brief Decode clips into the cache on the threads of JobSystem::Shared(), so sources
+         *        playing them on awake do not stall the first frame. Clips that are streamed are skipped.
+         * @details Nothing calls this by itself; the engine is expected to call it while it loads
+         *          a scene.
+         * @param cache The cache, with Register called on it. Must outlive the returned future.
+         * @param paths The clips, for example from PlayOnAwakeClips.
+         * @param threads The most threads decoding, at least 1. One of them is a thread of the
+         *        call's own, so the future becomes ready even when the pool has no workers.
+         * @return Becomes ready when all clips are loaded.
+         */
+        static std::future<PreloadReport> Preload(ResourceCache &cache, std::vector<std::string> paths,
+                                                  unsigned int threads = 2);
+
+        /**
+         * @brief The memory size of all decoded clips alive right now.
+         */
+        [[nodiscard]] static std::size_t LiveBytes() { return liveBytes.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief The highest LiveBytes since the program started.
+         */
+        [[nodiscard]] static std::size_t PeakBytes() { return peakBytes.load(std::memory_order_relaxed); }
+
+    private:
+        static std::atomic<std::size_t> streamThreshold;
+        static std::atomic<std::size_t> liveBytes;
+        static std::atomic<std::size_t> peakBytes;
+    };
+
+}
+
+#endif // AUDIOLOADER_H_
@@ -0,0 +1,315 @@
+#include "AudioMixer.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPIC_AUDIO_SSE2
+#endif
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief Add a run of mono samples to stereo output, with a gain per channel.
+     */
+    void MixMono(const float *source, float *output, std::size_t frames, float left, float right) {
+        std::size_t i = 0;
+#ifdef SPIC_AUDIO_SSE2
+        const __m128 gains = _mm_set_ps(right, left, right, left);
+        for (; i + 4 <= frames; i += 4) {
+            const __m128 samples = _mm_loadu_ps(source + i);
+            float *out = output + i * 2;
+            _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(_mm_unpacklo_ps(samples, samples), gains)));
+            _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4),
+                                              _mm_mul_ps(_mm_unpackhi_ps(samples, samples), gains)));
+        }
+#endif
+        for (; i < frames; ++i) {
+            output[i * 2] += source[i] * left;
+            output[i * 2 + 1] += source[i] * right;
+        }
+    }
+
+    /**
+     * @brief Add a run of stereo frames to stereo output, with a gain per channel.
+     */
+    void MixStereo(const float *source, float *output, std::size_t frames, float left, float right) {
+        std::size_t i = 0;
+#ifdef SPIC_AUDIO_SSE2
+        const __m128 gains = _mm_set_ps(right, left, right, left);
+        for (; i + 2 <= frames; i += 2) {
+            _mm_storeu_ps(output + i * 2, _mm_add_ps(_mm_loadu_ps(output + i * 2),
+                                                     _mm_mul_ps(_mm_loadu_ps(source + i * 2), gains)));
+        }
+#endif
+        for (; i < frames; ++i) {
+            output[i * 2] += source[i * 2] * left;
+            output[i * 2 + 1] += source[i * 2 + 1] * right;
+        }
+    }
+
+    void Clamp(float *samples, std::size_t count) {
+        std::size_t i = 0;
+#ifdef SPIC_AUDIO_SSE2
+        const __m128 low = _mm_set1_ps(-1);
+        const __m128 high = _mm_set1_ps(1);
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(samples + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), low), high));
+        }
+#endif
+        for (; i < count; ++i) samples[i] = std::min(std::max(samples[i], -1.0f), 1.0f);
+    }
+
+    /**
+     * @brief The number of frames read from a stream at a time.
+     */
+    constexpr std::size_t streamFrames = 1024;
+
+}
+
+AudioMixer::AudioMixer(int sampleRate, std::size_t maxVoices, std::size_t commandCapacity)
+    : sampleRate {sampleRate}, commands {commandCapacity}, states(maxVoices), slots(maxVoices),
+      ended {std::make_unique<std::atomic<std::uint32_t>[]>(maxVoices)}, streamBlock(streamFrames * 2) {
+    for (std::size_t index = maxVoices; index > 0; --index) freeVoices.push_back(static_cast<std::uint32_t>(index - 1));
+}
+
+AudioMixer::~AudioMixer() {
+    Shutdown();
+}
+
+AudioMixer::Voice AudioMixer::Play(std::shared_ptr<const AudioSamples> clip, float volume, float pan, bool looping,
+                                   std::size_t startFrame) {
+    if (freeVoices.empty() || clip == nullptr || clip->Frames() == 0) return noVoice;
+
+    const std::uint32_t index = freeVoices.back();
+    VoiceSlot &slot = slots[index];
+    if (!Send({CommandType::play, index, slot.generation + 1, clip.get(), nullptr, startFrame, volume, pan,
+               looping})) {
+        return noVoice;
+    }
+
+    freeVoices.pop_back();
+    ++slot.generation;
+    slot.source = std::move(clip);
+    slot.inUse = true;
+    return MakeVoice(index, slot.generation);
+}
+
+AudioMixer::Voice AudioMixer::Play(std::shared_ptr<AudioStream> stream, float volume, float pan) {
+    if (freeVoices.empty() || stream == nullptr || stream->Rate() != sampleRate) return noVoice;
+
+    const std::uint32_t index = freeVoices.back();
+    VoiceSlot &slot = slots[index];
+    if (!Send({CommandType::play, index, slot.generation + 1, nullptr, stream.get(), 0, volume, pan, false})) {
+        return noVoice;
+    }
+
+    freeVoices.pop_back();
+    ++slot.generation;
+    slot.source = std::move(stream);
+    slot.inUse = true;
+    return MakeVoice(index, slot.generation);
+}
+
+bool AudioMixer::Stop(Voice voice) {
+    if (!Current(voice)) return true;
+
+    const std::uint32_t index = IndexOf(voice);
+    if (!Send({CommandType::stop, index, GenerationOf(voice), nullptr, nullptr, 0, 0, 0, false})) return false;
+    Release(index);
+    return true;
+}
+
+void AudioMixer::Volume(Voice voice, float volume) {
+    if (Current(voice)) {
+        Send({CommandType::volume, IndexOf(voice), GenerationOf(voice), nullptr, nullptr, 0, volume, 0, false});
+    }
+}
+
+void AudioMixer::Pan(Voice voice, float pan) {
+    if (Current(voice)) {
+        Send({CommandType::pan, IndexOf(voice), GenerationOf(voice), nullptr, nullptr, 0, 0, pan, false});
+    }
+}
+
+bool AudioMixer::Playing(Voice voice) const {
+    return Current(voice) && ended[IndexOf(voice)].load(std::memory_order_acquire) != GenerationOf(voice);
+}
+
+void AudioMixer::Update() {
+    for (std::uint32_t index = 0; index < slots.size(); ++index) {
+        if (slots[index].inUse && ended[index].load(std::memory_order_acquire) == slots[index].generation) {
+            Release(index);
+        }
+    }
+
+    const std::uint64_t applied = commandsApplied.load(std::memory_order_acquire);
+    retired.erase(std::remove_if(retired.begin(), retired.end(), [&](const auto &entry) {
+        return entry.first <= applied;
+    }), retired.end());
+}
+
+bool AudioMixer::Current(Voice voice) const {
+    const std::uint32_t index = IndexOf(voice);
+    return voice != noVoice && index < slots.size() && slots[index].inUse &&
+           slots[index].generation == GenerationOf(voice);
+}
+
+bool AudioMixer::Send(const Command &command) {
+    if (!commands.Push(command)) return false;
+    ++commandsSent;
+    return true;
+}
+
+void AudioMixer::Release(std::uint32_t index) {
+    // The mixer may still be reading the clip until it has applied every command sent so far.
+    retired.emplace_back(commandsSent, std::move(slots[index].source));
+    slots[index].inUse = false;
+    freeVoices.push_back(index);
+}
+
+void AudioMixer::Mix(float *output, std::size_t frames) {
+    Command command {};
+    std::uint64_t applied = 0;
+    while (commands.Pop(command)) {
+        Apply(command);
+        ++applied;
+    }
+    if (applied > 0) commandsApplied.fetch_add(applied, std::memory_order_release);
+
+    std::fill(output, output + frames * 2, 0.0f);
+    for (VoiceState &voice: states) {
+        if (!voice.active) continue;
+        if (voice.stream != nullptr) {
+            MixStream(voice, output, frames);
+        } else {
+            MixVoice(voice, output, frames);
+        }
+    }
+    Clamp(output, frames * 2);
+
+    framesMixed.fetch_add(frames, std::memory_order_relaxed);
+}
+
+void AudioMixer::Apply(const Command &command) {
+    VoiceState &voice = states[command.index];
+    // Commands for an earlier play of the slot are stale.
+    if (command.type != CommandType::play && command.generation != voice.generation) return;
+
+    switch (command.type) {
+        case CommandType::play:
+            voice = {command.clip, command.stream, static_cast<double>(command.startFrame), command.value,
+                     command.pan, command.generation, command.looping, true};
+            break;
+        case CommandType::stop:
+            voice.active = false;
+            voice.clip = nullptr;
+            voice.stream = nullptr;
+            break;
+        case CommandType::volume:
+            voice.volume = command.value;
+            break;
+        case CommandType::pan:
+            voice.pan = command.pan;
+            break;
+    }
+}
+
+void AudioMixer::MixVoice(VoiceState &voice, float *output, std::size_t frames) {
+    const AudioSamples &clip = *voice.clip;
+    const std::size_t length = clip.Frames();
+    const bool mono = clip.channels == 1;
+
+    // Constant power panning for mono clips, balance for stereo ones.
+    const float pan = std::min(std::max(voice.pan, -1.0f), 1.0f);
+    const float angle = (pan + 1) * 0.785398163f;
+    const float left = voice.volume * (mono ? std::cos(angle) : std::min(1.0f, 1 - pan));
+    const float right = voice.volume * (mono ? std::sin(angle) : std::min(1.0f, 1 + pan));
+    const double step = static_cast<double>(clip.sampleRate) / sampleRate;
+
+    std::size_t done = 0;
+    while (done < frames) {
+        if (voice.position >= static_cast<double>(length)) {
+            if (!voice.looping) {
+                End(voice);
+                return;
+            }
+            voice.position = std::fmod(voice.position, static_cast<double>(length));
+        }
+
+        if (step == 1 && voice.position == std::floor(voice.position)) {
+            // Same rate: mix straight from the clip, up to its end.
+            const auto start = static_cast<std::size_t>(voice.position);
+            const std::size_t run = std::min(frames - done, length - start);
+            const float *source = clip.samples.data() + start * clip.channels;
+            if (mono) {
+                MixMono(source, output + done * 2, run, left, right);
+            } else {
+                MixStereo(source, output + done * 2, run, left, right);
+            }
+            voice.position += static_cast<double>(run);
+            done += run;
+            continue;
+        }
+
+        // Other rate: linear interpolation, frame by frame.
+        for (; done < frames && voice.position < static_cast<double>(length); ++done, voice.position += step) {
+            const auto index = static_cast<std::size_t>(voice.position);
+            const auto fraction = static_cast<float>(voice.position - static_cast<double>(index));
+            const std::size_t next = index + 1 < length ? index + 1 : voice.looping ? 0 : index;
+            const float *a = clip.samples.data() + index * clip.channels;
+            const float *b = clip.samples.data() + next * clip.channels;
+            const float sampleLeft = a[0] + (b[0] - a[0]) * fraction;
+            const float sampleRight = mono ? sampleLeft : a[1] + (b[1] - a[1]) * fraction;
+            output[done * 2] += sampleLeft * left;
+            output[done * 2 + 1] += sampleRight * right;
+        }
+    }
+}
+
+void AudioMixer::MixStream(VoiceState &voice, float *output, std::size_t frames) {
+    // Streams are stereo at the output rate, so only balance is applied.
+    const float pan = std::min(std::max(voice.pan, -1.0f), 1.0f);
+    const float left = voice.volume * std::min(1.0f, 1 - pan);
+    const float right = voice.volume * std::min(1.0f, 1 + pan);
+
+    for (std::size_t done = 0; done < frames;) {
+        const std::size_t wanted = std::min(frames - done, streamFrames);
+        const std::size_t read = voice.stream->Read(streamBlock.data(), wanted);
+        MixStereo(streamBlock.data(), output + done * 2, read, left, right);
+        done += read;
+
+        if (read < wanted) {
+            // Either the clip has ended, or decoding fell behind and the rest stays silent.
+            if (voice.stream->Finished()) End(voice);
+            return;
+        }
+    }
+}
+
+void AudioMixer::End(VoiceState &voice) {
+    voice.active = false;
+    ended[&voice - states.data()].store(voice.generation, std::memory_order_release);
+}
+
+void AudioMixer::Start(std::unique_ptr<IAudioSink> newSink, std::size_t blockFrames) {
+    Shutdown();
+    sink = std::move(newSink);
+    running.store(true);
+
+    thread = std::thread([this, blockFrames] {
+        std::vector<float> block(blockFrames * 2);
+        while (running.load(std::memory_order_acquire)) {
+            Mix(block.data(), blockFrames);
+            sink->Write(block.data(), blockFrames);
+        }
+    });
+}
+
+void AudioMixer::Shutdown() {
+    running.store(false);
+    if (thread.joinable()) thread.join();
+    sink.reset();
+}
@@ -0,0 +1,262 @@
+#ifndef AUDIOMIXER_H_
+#define AUDIOMIXER_H_
+
+#include "AudioSink.hpp"
+#include "AudioStream.hpp"
+#include "SpscRing.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief A decoded sound: interleaved float samples between -1 and 1.
+     */
+    struct AudioSamples {
+        int sampleRate;
+        int channels;
+        std::vector<float> samples;
+
+        [[nodiscard]] std::size_t Frames() const { return samples.size() / channels; }
+    };
+
+    /**
+     * @brief Mixes all playing sounds into one stereo stream, on a thread of its own.
+     * @details The game thread controls voices through Play, Stop, Volume and Pan, which only
+     *          push a command into a lock-free queue; the mixer applies queued commands at the
+     *          start of every block, so neither side ever waits for the other. Clips stay alive
+     *          while the mixer may still read them: the game thread releases them in Update,
+     *          once the mixer has confirmed it is past the command that stopped them. Long clips
+     *          are played from an AudioStream instead of being decoded whole. Volume and panning
+     *          are applied with SSE2 when the compiler targets it.
+     */
+    class AudioMixer {
+    public:
+        /**
+         * @brief A handle to one play of a sound: the voice slot in the low 32 bits and the
+         *        slot's generation in the high 32 bits, so a handle kept after its sound ended
+         *        and the slot was reused no longer affects the slot.
+         */
+        using Voice = std::uint64_t;
+
+        /**
+         * @brief Returned by Play when no voice could be started.
+         */
+        static constexpr Voice noVoice = ~Voice {0};
+
+        /**
+         * @brief Constructor.
+         * @param sampleRate The output sample rate; clips at other rates are resampled.
+         * @param maxVoices The number of voices that can play at once.
+         * @param commandCapacity The number of commands that can wait for the mixer.
+         */
+        explicit AudioMixer(int sampleRate = 48000, std::size_t maxVoices = 256, std::size_t commandCapacity = 1024);
+
+        /**
+         * @brief Destructor, stopping the mixer thread.
+         */
+        ~AudioMixer();
+
+        AudioMixer(const AudioMixer &other) = delete;
+
+        AudioMixer &operator=(const AudioMixer &other) = delete;
+
+        /**
+         * @brief Start playing a clip. Game thread only.
+         * @param clip The sound.
+         * @param volume The volume, 0 ≤ volume ≤ 1.
+         * @param pan The position from left (-1) to right (1).
+         * @param looping Start over when the end is reached.
+         * @param startFrame The frame of the clip to start at.
+         * @return The voice playing the clip, or noVoice if all voices are busy or the command
+         *         queue is full.
+         */
+        Voice Play(std::shared_ptr<const AudioSamples> clip, float volume, float pan, bool looping,
+                   std::size_t startFrame = 0);
+
+        /**
+         * @brief Start playing a stream. Game thread only.
+         * @param stream The stream, already added to an AudioStreamer at the mixer's sample rate;
+         *        it loops if it was opened looping.
+         * @param volume The volume, 0 ≤ volume ≤ 1.
+         * @param pan The balance from left (-1) to right (1).
+         * @return The voice playing the stream, or noVoice if all voices are busy, the command
+         *         queue is full, or the stream was opened for another sample rate.
+         */
+        Voice Play(std::shared_ptr<AudioStream> stream, float volume, float pan);
+
+        /**
+         * @brief Stop a voice. Game thread only.
+         * @return false if the command queue is full, in which case the voice keeps playing;
+         *         true otherwise, also when the voice had already ended.
+         */
+        bool Stop(Voice voice);
+
+        /**
+         * @brief Change the volume of a voice, 0 ≤ volume ≤ 1. Does nothing once the voice has
+         *        ended. Game thread only.
+         */
+        void Volume(Voice voice, float volume);
+
+        /**
+         * @brief Change the position of a voice from left (-1) to right (1). Does nothing once
+         *        the voice has ended. Game thread only.
+         */
+        void Pan(Voice voice, float pan);
+
+        /**
+         * @brief Whether a voice is still playing; false once a non-looping clip has ended, or
+         *        the voice was stopped. Game thread only.
+         */
+        [[nodiscard]] bool Playing(Voice voice) const;
+
+        /**
+         * @brief Free the voices and clips the mixer is done with. Call once per frame from the
+         *        game thread.
+         */
+        void Update();
+
+        /**
+         * @brief Apply queued commands and mix the next frames. This is the body of the mixer
+         *        thread, and can be called directly from a sound device's callback instead.
+         *        Never blocks or allocates.
+         * @param output Receives frames stereo frames, left and right interleaved.
+         * @param frames The number of frames.
+         */
+        void Mix(float *output, std::size_t frames);
+
+        /**
+         * @brief Start the mixer thread, which mixes blocks and writes them to a sink until
+         *        Shutdown. The sink's Write is expected to block to keep pace.
+         * @param sink The output, at the mixer's sample rate.
+         * @param blockFrames The number of frames mixed at a time.
+         */
+        void Start(std::unique_ptr<IAudioSink> sink, std::size_t blockFrames = 512);
+
+        /**
+         * @brief Stop the mixer thread and drop its sink.
+         */
+        void Shutdown();
+
+        [[nodiscard]] int SampleRate() const { return sampleRate; }
+
+        /**
+         * @brief The number of frames mixed so far; may be read from any thread.
+         */
+        [[nodiscard]] std::uint64_t FramesMixed() const { return framesMixed.load(std::memory_order_relaxed); }
+
+    private:
+        enum class CommandType {
+            play,
+            stop,
+            volume,
+            pan
+        };
+
+        struct Command {
+            CommandType type;
+            std::uint32_t index;
+            std::uint32_t generation;
+            const AudioSamples *clip;
+            AudioStream *stream;
+            std::size_t startFrame;
+            float value;
+            float pan;
+            bool looping;
+        };
+
+        /**
+         * @brief A voice as seen by the mixer; only touched by the thread calling Mix.
+         */
+        struct VoiceState {
+            const AudioSamples *clip;
+            AudioStream *stream;
+            double position;
+            float volume;
+            float pan;
+            std::uint32_t generation;
+            bool looping;
+            bool active;
+        };
+
+        /**
+         * @brief A voice as seen by the game thread.
+         */
+        struct VoiceSlot {
+            /**
+             * @brief The clip or stream, kept alive while the mixer may read it.
+             */
+            std::shared_ptr<const void> source;
+            std::uint32_t generation;
+            bool inUse;
+        };
+
+        static Voice MakeVoice(std::uint32_t index, std::uint32_t generation) {
+            return static_cast<Voice>(generation) << 32 | index;
+        }
+
+        static std::uint32_t IndexOf(Voice voice) { return static_cast<std::uint32_t>(voice); }
+
+        static std::uint32_t GenerationOf(Voice voice) { return static_cast<std::uint32_t>(voice >> 32); }
+
+        /**
+         * @brief Whether a handle refers to the current play of its slot.
+         */
+        [[nodiscard]] bool Current(Voice voice) const;
+
+        bool Send(const Command &command);
+
+        void Apply(const Command &command);
+
+        void Release(std::uint32_t index);
+
+        void MixVoice(VoiceState &voice, float *output, std::size_t frames);
+
+        void MixStream(VoiceState &voice, float *output, std::size_t frames);
+
+        void End(VoiceState &voice);
+
+        int sampleRate;
+        SpscRing<Command> commands;
+        std::vector<VoiceState> states;
+        std::vector<VoiceSlot> slots;
+        std::vector<std::uint32_t> freeVoices;
+
+        /**
+         * @brief Per voice, the generation of the last play that ended by itself; written by the
+         *        mixer, read by the game thread.
+         */
+        std::unique_ptr<std::atomic<std::uint32_t>[]> ended;
+
+        /**
+         * @brief Commands sent by the game thread and applied by the mixer, for knowing when a
+         *        clip is no longer read.
+         */
+        std::uint64_t commandsSent {0};
+        std::atomic<std::uint64_t> commandsApplied {0};
+
+        /**
+         * @brief Clips and streams of stopped voices, with the number of commands that had been
+         *        sent when they were stopped.
+         */
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<const void>>> retired;
+
+        /**
+         * @brief Frames read from streams before they are mixed, allocated up front.
+         */
+        std::vector<float> streamBlock;
+
+        std::atomic<std::uint64_t> framesMixed {0};
+        std::atomic<bool> running {false};
+        std::unique_ptr<IAudioSink> sink;
+        std::thread thread;
+    };
+
+}
+
+#endif // AUDIOMIXER_H_
@@ -0,0 +1,66 @@
+#include "AudioSink.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace spic;
+
+namespace {
+
+    void PutLittleEndian(std::ofstream &out, std::uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) out.put(static_cast<char>(value >> (8 * i)));
+    }
+
+}
+
+NullSink::NullSink(int sampleRate, bool realTime)
+    : sampleRate {sampleRate}, realTime {realTime}, start {std::chrono::steady_clock::now()} {}
+
+void NullSink::Write(const float *, std::size_t count) {
+    framesWritten += count;
+    if (!realTime) return;
+
+    // Block until a device playing at sampleRate would have consumed everything written.
+    std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(framesWritten) / sampleRate)));
+}
+
+WavFileSink::WavFileSink(const std::string &path, int sampleRate)
+    : out {path, std::ios::binary}, sampleRate {sampleRate} {
+    if (!out) throw std::runtime_error("Cannot create '" + path + "'");
+    WriteHeader();
+}
+
+WavFileSink::~WavFileSink() {
+    out.seekp(0);
+    WriteHeader();
+}
+
+void WavFileSink::Write(const float *frames, std::size_t count) {
+    std::vector<char> bytes(count * 4);
+    for (std::size_t i = 0; i < count * 2; ++i) {
+        const auto sample = static_cast<std::int16_t>(std::lround(std::min(std::max(frames[i], -1.0f), 1.0f) * 32767));
+        bytes[i * 2] = static_cast<char>(sample & 0xFF);
+        bytes[i * 2 + 1] = static_cast<char>((sample >> 8) & 0xFF);
+    }
+
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    dataBytes += static_cast<std::uint32_t>(bytes.size());
+}
+
+void WavFileSink::WriteHeader() {
+    out.write("RIFF", 4);
+    PutLittleEndian(out, 36 + dataBytes, 4);
+    out.write("WAVEfmt ", 8);
+    PutLittleEndian(out, 16, 4);
+    PutLittleEndian(out, 1, 2); // PCM
+    PutLittleEndian(out, 2, 2); // stereo
+    PutLittleEndian(out, static_cast<std::uint32_t>(sampleRate), 4);
+    PutLittleEndian(out, static_cast<std::uint32_t>(sampleRate) * 4, 4);
+    PutLittleEndian(out, 4, 2);
+    PutLittleEndian(out, 16, 2);
+    out.write("data", 4);
+    PutLittleEndian(out, dataBytes, 4);
+}
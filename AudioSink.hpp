@@ -0,0 +1,90 @@
+#ifndef AUDIOSINK_H_
+#define AUDIOSINK_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace spic {
+
+    /**
+     * @brief Where the AudioMixer sends its output: a sound device, or one of the headless sinks
+     *        below. Output is stereo, as interleaved float samples between -1 and 1.
+     */
+    class IAudioSink {
+    public:
+        virtual ~IAudioSink() = default;
+
+        /**
+         * @brief Consume mixed audio. Device sinks block until the device has room, which is
+         *        what paces the mixer thread.
+         * @param frames count stereo frames, left and right interleaved.
+         * @param count The number of frames.
+         */
+        virtual void Write(const float *frames, std::size_t count) = 0;
+
+        [[nodiscard]] virtual int SampleRate() const = 0;
+    };
+
+    /**
+     * @brief A sink that drops its input, for running and benchmarking the mixer headless.
+     */
+    class NullSink : public IAudioSink {
+    public:
+        /**
+         * @brief Constructor.
+         * @param sampleRate The sample rate to report.
+         * @param realTime Make Write wait as long as a device would take to play the frames;
+         *        otherwise the mixer runs as fast as it can.
+         */
+        explicit NullSink(int sampleRate = 48000, bool realTime = false);
+
+        void Write(const float *frames, std::size_t count) override;
+
+        [[nodiscard]] int SampleRate() const override { return sampleRate; }
+
+        /**
+         * @brief The number of frames written so far.
+         */
+        [[nodiscard]] std::uint64_t FramesWritten() const { return framesWritten; }
+
+    private:
+        int sampleRate;
+        bool realTime;
+        std::uint64_t framesWritten {0};
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief A sink that records its input into a 16-bit stereo WAV file.
+     */
+    class WavFileSink : public IAudioSink {
+    public:
+        /**
+         * @brief Constructor, creating the file.
+         * @exception A std::runtime_error is thrown when the file cannot be created.
+         */
+        explicit WavFileSink(const std::string &path, int sampleRate = 48000);
+
+        /**
+         * @brief Destructor, completing the file's header.
+         */
+        ~WavFileSink() override;
+
+        void Write(const float *frames, std::size_t count) override;
+
+        [[nodiscard]] int SampleRate() const override { return sampleRate; }
+
+    private:
+        void WriteHeader();
+
+        std::ofstream out;
+        int sampleRate;
+        std::uint32_t dataBytes {0};
+    };
+
+}
+
+#endif // AUDIOSINK_H_
@@ -2,6 +2,7 @@
 #define AUDIOSOURCE_H_
 
 #include "Component.hpp"
+#include "VoiceManager.hpp"
 #include <string>
 
 namespace spic {
@@ -15,6 +16,9 @@ namespace spic {
 
         /**
          * @brief Call this method to start playing audio.
+         * @details Starts the clip in the VoiceManager, which only mixes it while it ranks among
+         *          the most important and loudest playing sources, and returns immediately.
+         *          Streamed clips are played by the AudioMixer directly.
          * @param looping Automatically start over when done.
          * @spicapi
          */
@@ -22,6 +26,7 @@ namespace spic {
 
         /**
          * @brief Call this method to stop playing audio.
+         * @details Returns immediately; a real voice is stopped at the next mixer block.
          * @spicapi
          */
         void Stop();
@@ -32,6 +37,12 @@ namespace spic {
 
         bool PlayOnAwake() const;
 
+        /**
+         * @brief Set whether the clip starts playing when the scene starts.
+         * @details The engine should decode the clips of such sources before the scene starts, by
+         *          passing AudioLoader::PlayOnAwakeClips to AudioLoader::Preload when it loads the
+         *          scene; clips not preloaded are decoded on the first Play.
+         */
         void PlayOnAwake(bool playOnAwake);
 
         bool Loop() const;
@@ -40,13 +51,27 @@ namespace spic {
 
         double Volume() const;
 
+        /**
+         * @brief Set the volume, between 0.0 and 1.0; a playing voice follows at the next mixer block.
+         */
         void Volume(double volume);
 
+        [[nodiscard]] int Priority() const;
+
+        /**
+         * @brief Set how important the sound is. When more sources play than there are real
+         *        voices, those with the highest priority are mixed first, then the loudest.
+         */
+        void Priority(int priority);
+
         bool ShouldPlay() const;
 
     private:
         /**
          * @brief Path to a locally stored audio file.
+         * @details Short clips are decoded through the ResourceCache, so sources playing the same
+         *          clip share one copy; clips for which AudioLoader::Streams is true are played
+         *          through an AudioStream of their own.
          */
         std::string audioClip;
 
@@ -69,6 +94,21 @@ namespace spic {
          * @brief Whether or not the audio should be played.
          */
         bool shouldPlay;
+
+        /**
+         * @brief Voice ranking priority, higher is more important.
+         */
+        int priority {0};
+
+        /**
+         * @brief The source in the VoiceManager playing a decoded clip, or VoiceManager::noSource.
+         */
+        VoiceManager::Source source {VoiceManager::noSource};
+
+        /**
+         * @brief The mixer voice playing a streamed clip, or AudioMixer::noVoice.
+         */
+        AudioMixer::Voice voice {AudioMixer::noVoice};
     };
 
 }
@@ -0,0 +1,131 @@
+#include "AudioStream.hpp"
+#include <algorithm>
+#include <chrono>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief The number of output frames decoded at a time.
+     */
+    constexpr std::size_t chunkFrames = 2048;
+
+}
+
+AudioStream::AudioStream(const std::string &path, int outputRate, bool looping, std::size_t bufferFrames)
+    : file {path}, format {WavFormat::Parse(file.Data(), file.Size(), path)}, rate {outputRate},
+      length {format.Frames()},
+      step {static_cast<double>(format.sampleRate) / outputRate}, looping {looping}, buffer {bufferFrames * 2} {
+    // Two extra source frames: one to interpolate towards, one against rounding of the position.
+    source.resize((static_cast<std::size_t>(chunkFrames * step) + 3) * format.channels);
+    output.resize(chunkFrames * 2);
+    if (length == 0) decoded.store(true, std::memory_order_release);
+    file.Prefetch(format.dataOffset, source.size() / format.channels * format.FrameBytes());
+}
+
+std::size_t AudioStream::Fill() {
+    // Only the streamer pushes, so the free space can only grow while this runs.
+    const std::size_t space = (buffer.Capacity() - buffer.Size()) / 2;
+    const std::size_t channels = format.channels;
+    std::size_t produced = 0;
+
+    while (produced < space && !decoded.load(std::memory_order_relaxed)) {
+        if (position >= static_cast<double>(length)) {
+            if (!looping) {
+                decoded.store(true, std::memory_order_release);
+                break;
+            }
+            position -= static_cast<double>(length);
+        }
+
+        const std::size_t want = std::min(space - produced, chunkFrames);
+        const auto first = static_cast<std::size_t>(position);
+        const std::size_t count = std::min(source.size() / channels, length - first);
+        format.Decode(file.Data() + format.dataOffset + first * format.FrameBytes(), count, source.data());
+
+        std::size_t frames = 0;
+        for (; frames < want && position < static_cast<double>(length); ++frames, position += step) {
+            const std::size_t index = static_cast<std::size_t>(position) - first;
+            if (index >= count) break;
+            const auto fraction = static_cast<float>(position - static_cast<double>(first + index));
+            const float *a = source.data() + index * channels;
+            const float *b = index + 1 < count ? a + channels : a;
+            const float left = a[0] + (b[0] - a[0]) * fraction;
+            output[frames * 2] = left;
+            output[frames * 2 + 1] = channels == 1 ? left : a[1] + (b[1] - a[1]) * fraction;
+        }
+
+        buffer.Push(output.data(), frames * 2);
+        produced += frames;
+
+        // Have the system read the next chunk from disk while this one plays.
+        const auto next = static_cast<std::size_t>(position);
+        if (next < length) file.Prefetch(format.dataOffset + next * format.FrameBytes(), count * format.FrameBytes());
+    }
+
+    return produced;
+}
+
+std::size_t AudioStream::Read(float *samples, std::size_t frames) {
+    // Fill pushes whole frames, so taking an even number of samples never splits one.
+    return buffer.Pop(samples, frames * 2) / 2;
+}
+
+bool AudioStream::Finished() const {
+    return decoded.load(std::memory_order_acquire) && buffer.Size() == 0;
+}
+
+AudioStreamer::AudioStreamer(int interval) : interval {interval} {}
+
+AudioStreamer::~AudioStreamer() {
+    Shutdown();
+}
+
+void AudioStreamer::Add(std::shared_ptr<AudioStream> stream) {
+    // The lock hands the stream over, so the thread continues where this Fill stopped.
+    stream->Fill();
+    std::lock_guard<std::mutex> lock {mutex};
+    streams.push_back(std::move(stream));
+}
+
+void AudioStreamer::Start() {
+    Shutdown();
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        running = true;
+    }
+
+    thread = std::thread([this] {
+        std::vector<std::shared_ptr<AudioStream>> filling;
+        std::unique_lock<std::mutex> lock {mutex};
+        while (running) {
+            streams.erase(std::remove_if(streams.begin(), streams.end(), [](const std::shared_ptr<AudioStream> &stream) {
+                return stream.use_count() == 1 || stream->Decoded();
+            }), streams.end());
+            filling = streams;
+
+            // Decode without the lock, so Add never waits for a pass over all streams.
+            lock.unlock();
+            for (const std::shared_ptr<AudioStream> &stream: filling) stream->Fill();
+            filling.clear();
+            lock.lock();
+
+            wake.wait_for(lock, std::chrono::milliseconds(interval), [this] { return !running; });
+        }
+    });
+}
+
+void AudioStreamer::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        running = false;
+    }
+    wake.notify_all();
+    if (thread.joinable()) thread.join();
+}
+
+std::size_t AudioStreamer::Size() const {
+    std::lock_guard<std::mutex> lock {mutex};
+    return streams.size();
+}
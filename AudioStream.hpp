@@ -0,0 +1,145 @@
+#ifndef AUDIOSTREAM_H_
+#define AUDIOSTREAM_H_
+
+#include "MappedFile.hpp"
+#include "SpscRing.hpp"
+#include "WavFormat.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief A long clip, such as music, decoded a little ahead of playback instead of all at once.
+     * @details The file is memory mapped, so only the pages around the playing position are
+     *          read. An AudioStreamer thread decodes the file in chunks, resampled to the mixer's
+     *          rate and converted to stereo, into a lock-free ring that the AudioMixer reads from.
+     *          Memory use is bounded by the ring, whatever the length of the clip.
+     */
+    class AudioStream {
+    public:
+        /**
+         * @brief Constructor.
+         * @param path The file.
+         * @param outputRate The sample rate of the mixer that will play the stream.
+         * @param looping Start over when the end is reached.
+         * @param bufferFrames The number of frames decoded ahead.
+         * @exception A std::runtime_error is thrown when the file cannot be read or is not a
+         *            supported format.
+         */
+        AudioStream(const std::string &path, int outputRate, bool looping, std::size_t bufferFrames = 16384);
+
+        AudioStream(const AudioStream &other) = delete;
+
+        AudioStream &operator=(const AudioStream &other) = delete;
+
+        /**
+         * @brief Decode frames until the ring is full or the clip has ended. Streamer thread only.
+         * @return The number of frames added.
+         */
+        std::size_t Fill();
+
+        /**
+         * @brief Take decoded frames. Mixer thread only; never blocks or allocates.
+         * @param output Receives up to frames stereo frames.
+         * @return The number of frames taken; less than asked for when decoding fell behind or
+         *         the clip has ended.
+         */
+        std::size_t Read(float *output, std::size_t frames);
+
+        /**
+         * @brief Whether the end of a non-looping clip has been decoded and read.
+         */
+        [[nodiscard]] bool Finished() const;
+
+        /**
+         * @brief Whether the end of a non-looping clip has been decoded; nothing is left to Fill.
+         */
+        [[nodiscard]] bool Decoded() const { return decoded.load(std::memory_order_acquire); }
+
+        [[nodiscard]] const WavFormat &Format() const { return format; }
+
+        /**
+         * @brief The sample rate the stream is resampled to, which must match the mixer's.
+         */
+        [[nodiscard]] int Rate() const { return rate; }
+
+    private:
+        MappedFile file;
+        WavFormat format;
+        int rate;
+        std::size_t length;
+        double step;
+        bool looping;
+
+        /**
+         * @brief The next source frame to decode, fractional when resampling.
+         */
+        double position {0};
+
+        std::atomic<bool> decoded {false};
+        SpscRing<float> buffer;
+
+        /**
+         * @brief Scratch space of the streamer thread: decoded source frames, and output frames.
+         */
+        std::vector<float> source;
+        std::vector<float> output;
+    };
+
+    /**
+     * @brief A thread keeping AudioStream rings filled.
+     * @details Streams are dropped once fully decoded, or once nobody but the streamer holds them.
+     */
+    class AudioStreamer {
+    public:
+        /**
+         * @brief Constructor.
+         * @param interval How often the thread tops up the streams, in milliseconds; the rings
+         *        must hold more than this much audio.
+         */
+        explicit AudioStreamer(int interval = 10);
+
+        /**
+         * @brief Destructor, stopping the thread.
+         */
+        ~AudioStreamer();
+
+        AudioStreamer(const AudioStreamer &other) = delete;
+
+        AudioStreamer &operator=(const AudioStreamer &other) = delete;
+
+        /**
+         * @brief Fill a stream's ring, then keep it filled on the streamer thread.
+         * @details Call before handing the stream to AudioMixer::Play, so playback starts
+         *          without waiting for the thread.
+         */
+        void Add(std::shared_ptr<AudioStream> stream);
+
+        void Start();
+
+        void Shutdown();
+
+        /**
+         * @brief The number of streams being filled.
+         */
+        [[nodiscard]] std::size_t Size() const;
+
+    private:
+        int interval;
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<std::shared_ptr<AudioStream>> streams;
+        bool running {false};
+        std::thread thread;
+    };
+
+}
+
+#endif // AUDIOSTREAM_H_
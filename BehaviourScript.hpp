@@ -3,11 +3,89 @@
 
 #include "Component.hpp"
 #include "Collider.hpp"
+#include "Coroutine.hpp"
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace spic {
 
+    class GameObject;
+
+    /**
+     * @brief What a script touches during OnUpdate, see BehaviourScript::Access.
+     */
+    struct ScriptAccess {
+        /**
+         * @brief The component types the script reads.
+         */
+        std::vector<std::type_index> reads;
+
+        /**
+         * @brief The component types the script writes.
+         */
+        std::vector<std::type_index> writes;
+
+        /**
+         * @brief The script touches nothing shared, or synchronizes itself.
+         */
+        bool threadSafe;
+
+        /**
+         * @brief The component types the script reads and writes on owner only. Unlike writes,
+         *        these do not conflict with the same types on other objects.
+         */
+        std::vector<std::type_index> writesOwn {};
+
+        /**
+         * @brief The object of writesOwn. Components do not know their GameObject, so the script
+         *        names it; without one, writesOwn counts as writes.
+         */
+        const GameObject *owner {nullptr};
+
+        /**
+         * @brief Whether OnUpdate may run on a worker thread.
+         */
+        [[nodiscard]] bool Parallel() const {
+            return threadSafe || !reads.empty() || !writes.empty() || !writesOwn.empty();
+        }
+
+        /**
+         * @brief Shorthand for listing types, as in ScriptAccess {Types<Transform>(), Types<RigidBody>(), false}.
+         */
+        template<class... T>
+        static std::vector<std::type_index> Types() { return {std::type_index(typeid(T))...}; }
+    };
+
     class BehaviourScript : public Component {
     public:
+        /**
+         * @brief Stops the coroutines this script still runs, unless CoroutineScheduler::Shared()
+         *        was never created or is already destroyed.
+         */
+        ~BehaviourScript() {
+            if (destroyed != nullptr) destroyed(*this);
+        }
+
+#ifdef SPIC_COROUTINES
+        /**
+         * @brief Run a coroutine, usually a method of this script, in CoroutineScheduler::Shared().
+         * @details Runs it up to its first co_await right away. While it waits it costs no time
+         *          per frame, unlike polling Time::DeltaTime() in OnUpdate. Like StopCoroutine and
+         *          StopAllCoroutines, only call it from the main thread, so not from an OnUpdate
+         *          that a ScriptScheduler runs on a worker.
+         * @return An id for StopCoroutine.
+         */
+        CoroutineScheduler::Id StartCoroutine(Coroutine coroutine) {
+            return CoroutineScheduler::Shared().Start(*this, std::move(coroutine));
+        }
+
+        void StopCoroutine(CoroutineScheduler::Id id) { CoroutineScheduler::Shared().Stop(id); }
+
+        void StopAllCoroutines() { CoroutineScheduler::Shared().StopAll(*this); }
+#endif
+
         /**
          * @brief Setting up the behaviourscript. Is called when a scene is set as currentScene
          * @spicapi
@@ -21,6 +99,16 @@ namespace spic {
          */
         virtual void OnUpdate();
 
+        /**
+         * @brief Declare what OnUpdate reads and writes, so a ScriptScheduler can run it on a
+         *        worker thread together with the scripts it does not conflict with.
+         * @details Asked whenever the scheduler regroups its scripts. By default nothing is
+         *          declared and OnUpdate runs on the main thread. Types changed on the script's own
+         *          object only belong in ScriptAccess::writesOwn, so scripts of many objects can
+         *          still run together.
+         */
+        virtual ScriptAccess Access() const { return {{}, {}, false}; }
+
         /**
          * @brief Sent when another object enters a trigger collider
          *        attached to this object (2D physics only).
@@ -41,6 +129,15 @@ namespace spic {
          * @spicapi
          */
         virtual void OnTriggerStay2D(const Collider &collider);
+
+    private:
+        friend class CoroutineScheduler;
+
+        /**
+         * @brief Set while CoroutineScheduler::Shared() exists. Declared whether or not coroutines
+         *        are available, so every translation unit sees the same destructor.
+         */
+        static inline void (*destroyed)(const BehaviourScript &script) {nullptr};
     };
 
 }
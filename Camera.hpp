@@ -3,6 +3,8 @@
 
 #include "GameObject.hpp"
 #include "Color.hpp"
+#include "Rect.hpp"
+#include <cmath>
 
 namespace spic {
 
@@ -17,7 +19,7 @@ namespace spic {
                         bool active = true, int layer = 0, double aspectWidth = 0, double aspectHeight = 0,
                         bool autoInsert = false);
 
-        const Color &BackgroundColor() const;
+        Color BackgroundColor() const;
 
         void BackgroundColor(const Color &newBackgroundColor);
 
@@ -29,8 +31,25 @@ namespace spic {
 
         void AspectHeight(double newAspectHeight);
 
+        /**
+         * @brief The region of the world this camera shows.
+         * @details The view is AspectWidth × AspectHeight world units multiplied by the scale
+         *          of the camera's transform, centered on its position. When the camera is
+         *          rotated, the bounding rectangle of the rotated view is returned.
+         * @return The world-space view rectangle.
+         */
+        [[nodiscard]] Rect ViewRect() const {
+            const Transform &transform = TransformValue();
+            const double c = std::abs(std::cos(transform.rotation));
+            const double s = std::abs(std::sin(transform.rotation));
+            const double width = (aspectWidth * c + aspectHeight * s) * transform.scale;
+            const double height = (aspectWidth * s + aspectHeight * c) * transform.scale;
+
+            return {transform.position.x - width / 2, transform.position.y - height / 2, width, height};
+        }
+
     private:
-        Color backgroundColor;
+        Color32 backgroundColor;
         double aspectWidth;
         double aspectHeight;
     };
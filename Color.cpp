@@ -1,48 +1,143 @@
 #include "Color.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPIC_COLOR_SSE2
+#endif
+
 using namespace spic;
 
-Color Color::_white   {1.0, 1.0, 1.0, 1.0};
-Color Color::_red     {1.0, 0.0, 0.0, 1.0};
-Color Color::_green   {0.0, 1.0, 0.0, 1.0};
-Color Color::_blue    {0.0, 0.0, 1.0, 1.0};
-Color Color::_cyan    {0.0, 1.0, 1.0, 1.0};
-Color Color::_magenta {1.0, 0.0, 1.0, 1.0};
-Color Color::_yellow  {1.0, 1.0, 0.0, 1.0};
-Color Color::_black   {0.0, 0.0, 0.0, 1.0};
+const Color Color::_white   {1.0, 1.0, 1.0, 1.0};
+const Color Color::_red     {1.0, 0.0, 0.0, 1.0};
+const Color Color::_green   {0.0, 1.0, 0.0, 1.0};
+const Color Color::_blue    {0.0, 0.0, 1.0, 1.0};
+const Color Color::_cyan    {0.0, 1.0, 1.0, 1.0};
+const Color Color::_magenta {1.0, 0.0, 1.0, 1.0};
+const Color Color::_yellow  {1.0, 1.0, 0.0, 1.0};
+const Color Color::_black   {0.0, 0.0, 0.0, 1.0};
 // ... more standard colors here
 
-Color::Color(double red, double green, double blue, double alpha)
-    : r {red}, g {green}, b {blue}, a {alpha} {}
+namespace {
 
-double Color::R() {
-    return r;
-}
+    std::uint32_t Div255(std::uint32_t x) {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
 
-void Color::R(double newR) {
-    r = newR;
-}
+    std::uint8_t Quantize(float value) {
+        return static_cast<std::uint8_t>((value < 0 ? 0 : value > 1 ? 1 : value) * 255 + 0.5f);
+    }
 
-double Color::G() {
-    return g;
-}
+    /**
+     * @brief The weight of to in Lerp, in 256 steps like the channels.
+     */
+    std::uint32_t LerpWeight(float t) {
+        return Quantize(t);
+    }
+
+#ifdef SPIC_COLOR_SSE2
+
+    __m128i Div255(__m128i x) {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    __m128i QuantizeWide(const LinearColor &color) {
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_load_ps(&color.r), _mm_setzero_ps()), _mm_set1_ps(1));
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255)), _mm_set1_ps(0.5f)));
+    }
+
+    __m128i PremultiplyWide(__m128i colors) {
+        const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(colors, 0xFF), 0xFF);
+        // Alpha itself is multiplied by 255, which leaves it unchanged.
+        const __m128i factor = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha),
+                                            _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+        return Div255(_mm_mullo_epi16(colors, factor));
+    }
+
+#endif
 
-void Color::G(double newG) {
-    g = newG;
 }
 
-double Color::B() {
-    return b;
+void ColorBatch::Pack(const LinearColor *colors, Color32 *packed, std::size_t count) {
+    std::size_t i = 0;
+#ifdef SPIC_COLOR_SSE2
+    for (; i + 4 <= count; i += 4) {
+        const __m128i low = _mm_packs_epi32(QuantizeWide(colors[i]), QuantizeWide(colors[i + 1]));
+        const __m128i high = _mm_packs_epi32(QuantizeWide(colors[i + 2]), QuantizeWide(colors[i + 3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(packed + i), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < count; ++i) {
+        packed[i] = {Quantize(colors[i].r), Quantize(colors[i].g), Quantize(colors[i].b), Quantize(colors[i].a)};
+    }
 }
 
-void Color::B(double newB) {
-    b = newB;
+void ColorBatch::Unpack(const Color32 *packed, LinearColor *colors, std::size_t count) {
+    constexpr float scale = 1.0f / 255;
+    std::size_t i = 0;
+#ifdef SPIC_COLOR_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(packed + i));
+        const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        const __m128i words[4] = {_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero),
+                                  _mm_unpacklo_epi16(high, zero), _mm_unpackhi_epi16(high, zero)};
+        for (int k = 0; k < 4; ++k) {
+            _mm_store_ps(&colors[i + k].r, _mm_mul_ps(_mm_cvtepi32_ps(words[k]), _mm_set1_ps(scale)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        colors[i] = {packed[i].R() * scale, packed[i].G() * scale, packed[i].B() * scale, packed[i].A() * scale};
+    }
 }
 
-double Color::A() {
-    return a;
+void ColorBatch::Premultiply(Color32 *colors, std::size_t count) {
+    std::size_t i = 0;
+#ifdef SPIC_COLOR_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(colors + i));
+        const __m128i low = PremultiplyWide(_mm_unpacklo_epi8(bytes, zero));
+        const __m128i high = PremultiplyWide(_mm_unpackhi_epi8(bytes, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(colors + i), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < count; ++i) {
+        const std::uint32_t alpha = colors[i].A();
+        colors[i] = {static_cast<std::uint8_t>(Div255(colors[i].R() * alpha)),
+                     static_cast<std::uint8_t>(Div255(colors[i].G() * alpha)),
+                     static_cast<std::uint8_t>(Div255(colors[i].B() * alpha)), colors[i].A()};
+    }
 }
 
-void Color::A(double newA) {
-    a = newA;
+void ColorBatch::Lerp(const Color32 *from, const Color32 *to, float t, Color32 *result, std::size_t count) {
+    const std::uint32_t weight = LerpWeight(t);
+    std::size_t i = 0;
+#ifdef SPIC_COLOR_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i toWeight = _mm_set1_epi16(static_cast<short>(weight));
+    const __m128i fromWeight = _mm_set1_epi16(static_cast<short>(255 - weight));
+    for (; i + 4 <= count; i += 4) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(to + i));
+        const __m128i low = Div255(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), fromWeight),
+                                                 _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), toWeight)));
+        const __m128i high = Div255(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), fromWeight),
+                                                  _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), toWeight)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(result + i), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; i < count; ++i) {
+        std::uint32_t packed = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            const std::uint32_t a = from[i].rgba >> shift & 0xFF;
+            const std::uint32_t b = to[i].rgba >> shift & 0xFF;
+            packed |= Div255(a * (255 - weight) + b * weight) << shift;
+        }
+        result[i] = Color32 {packed};
+    }
 }
@@ -1,6 +1,9 @@
 #ifndef COLOR_H_
 #define COLOR_H_
 
+#include <cstddef>
+#include <cstdint>
+
 namespace spic {
 
     /**
@@ -16,7 +19,8 @@ namespace spic {
          * @param alpha The transparency component, 0 ≤ alpha ≤ 1.
          * @spicapi
          */
-        Color(double red, double green, double blue, double alpha);
+        constexpr Color(double red, double green, double blue, double alpha)
+                : r {red}, g {green}, b {blue}, a {alpha} {}
 
         /**
          * @brief One of the standard colors (read-only): white.
@@ -75,21 +79,21 @@ namespace spic {
         static const Color &black() { return _black; }
         // ... more standard colors here
 
-        double R();
+        constexpr double R() const { return r; }
 
-        void R(double newR);
+        void R(double newR) { r = newR; }
 
-        double G();
+        constexpr double G() const { return g; }
 
-        void G(double newG);
+        void G(double newG) { g = newG; }
 
-        double B();
+        constexpr double B() const { return b; }
 
-        void B(double newB);
+        void B(double newB) { b = newB; }
 
-        double A();
+        constexpr double A() const { return a; }
 
-        void A(double newA);
+        void A(double newA) { a = newA; }
 
     private:
         double r;
@@ -97,17 +101,106 @@ namespace spic {
         double b;
         double a;
 
-        static Color _white;
-        static Color _red;
-        static Color _green;
-        static Color _blue;
-        static Color _cyan;
-        static Color _magenta;
-        static Color _yellow;
-        static Color _black;
+        static const Color _white;
+        static const Color _red;
+        static const Color _green;
+        static const Color _blue;
+        static const Color _cyan;
+        static const Color _magenta;
+        static const Color _yellow;
+        static const Color _black;
         // ... more standard color here
     };
 
+    /**
+     * @brief A color packed in 32 bits, 8 bits per channel, red in the lowest byte.
+     * @details This is how components store colors: an eighth of the size of Color, and the
+     *          pixel format of textures and framebuffers.
+     */
+    struct Color32 {
+        std::uint32_t rgba;
+
+        constexpr Color32() : rgba {0} {}
+
+        constexpr explicit Color32(std::uint32_t packed) : rgba {packed} {}
+
+        constexpr Color32(std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha)
+                : rgba {red | static_cast<std::uint32_t>(green) << 8 | static_cast<std::uint32_t>(blue) << 16 |
+                        static_cast<std::uint32_t>(alpha) << 24} {}
+
+        /**
+         * @brief Convert from Color, rounding every channel to the nearest of 256 steps.
+         */
+        constexpr Color32(const Color &color)
+                : Color32(Quantize(color.R()), Quantize(color.G()), Quantize(color.B()), Quantize(color.A())) {}
+
+        constexpr std::uint8_t R() const { return static_cast<std::uint8_t>(rgba); }
+
+        constexpr std::uint8_t G() const { return static_cast<std::uint8_t>(rgba >> 8); }
+
+        constexpr std::uint8_t B() const { return static_cast<std::uint8_t>(rgba >> 16); }
+
+        constexpr std::uint8_t A() const { return static_cast<std::uint8_t>(rgba >> 24); }
+
+        constexpr Color ToColor() const { return {R() / 255.0, G() / 255.0, B() / 255.0, A() / 255.0}; }
+
+        constexpr bool operator==(const Color32 &other) const { return rgba == other.rgba; }
+
+        constexpr bool operator!=(const Color32 &other) const { return rgba != other.rgba; }
+
+    private:
+        static constexpr std::uint8_t Quantize(double value) {
+            return static_cast<std::uint8_t>((value < 0 ? 0 : value > 1 ? 1 : value) * 255 + 0.5);
+        }
+    };
+
+    /**
+     * @brief A color as four floats, laid out for SIMD kernels and GPU buffers. Channels are
+     *        stored as they are; no gamma curve is applied.
+     */
+    struct alignas(16) LinearColor {
+        float r;
+        float g;
+        float b;
+        float a;
+
+        constexpr LinearColor() : r {0}, g {0}, b {0}, a {0} {}
+
+        constexpr LinearColor(float red, float green, float blue, float alpha) : r {red}, g {green}, b {blue}, a {alpha} {}
+
+        constexpr LinearColor(const Color &color)
+                : r {static_cast<float>(color.R())}, g {static_cast<float>(color.G())},
+                  b {static_cast<float>(color.B())}, a {static_cast<float>(color.A())} {}
+    };
+
+    /**
+     * @brief Batch conversions and operations on colors, using SSE2 when the compiler targets it.
+     */
+    namespace ColorBatch {
+
+        /**
+         * @brief Convert float colors to packed ones, clamping every channel to [0, 1].
+         */
+        void Pack(const LinearColor *colors, Color32 *packed, std::size_t count);
+
+        /**
+         * @brief Convert packed colors to float ones.
+         */
+        void Unpack(const Color32 *packed, LinearColor *colors, std::size_t count);
+
+        /**
+         * @brief Multiply the red, green and blue channels by alpha, in place.
+         */
+        void Premultiply(Color32 *colors, std::size_t count);
+
+        /**
+         * @brief Interpolate between two arrays of colors: to[i] * t + from[i] * (1 - t).
+         * @param t The interpolation factor, 0 ≤ t ≤ 1.
+         */
+        void Lerp(const Color32 *from, const Color32 *to, float t, Color32 *result, std::size_t count);
+
+    }
+
 }
 
 #endif // COLOR_H_
@@ -0,0 +1,162 @@
+#include "Coroutine.hpp"
+
+#ifdef SPIC_COROUTINES
+
+#include "BehaviourScript.hpp"
+#include "Time.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace spic;
+
+Coroutine &Coroutine::operator=(Coroutine &&other) noexcept {
+    if (this != &other) {
+        if (handle) handle.destroy();
+        handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+}
+
+Coroutine::~Coroutine() {
+    if (handle) handle.destroy();
+}
+
+CoroutineScheduler::CoroutineScheduler(double resolution, bool shared)
+    : resolution {resolution}, shared {shared}, thread {std::this_thread::get_id()} {
+    if (shared) BehaviourScript::destroyed = &StopShared;
+}
+
+CoroutineScheduler::~CoroutineScheduler() {
+    // Scripts outliving the shared scheduler have nothing left to stop.
+    if (shared) BehaviourScript::destroyed = nullptr;
+    for (auto &[id, entry]: coroutines) entry.handle.destroy();
+}
+
+CoroutineScheduler::Id CoroutineScheduler::Start(const BehaviourScript &owner, Coroutine coroutine) {
+    assert(OwnThread() && "Coroutines are started from the thread that created the scheduler");
+    const Coroutine::Handle handle = coroutine.Release();
+    const Id id = nextId++;
+    handle.promise().scheduler = this;
+    handle.promise().id = id;
+    coroutines.emplace(id, Entry {handle, &owner});
+    owned[&owner].push_back(id);
+
+    Resume(id);
+    return coroutines.count(id) > 0 ? id : 0;
+}
+
+void CoroutineScheduler::Stop(Id id) {
+    assert(OwnThread() && "Coroutines are stopped from the thread that created the scheduler");
+    Erase(id);
+}
+
+void CoroutineScheduler::StopAll(const BehaviourScript &owner) {
+    assert(OwnThread() && "Coroutines are stopped from the thread that created the scheduler");
+    const auto found = owned.find(&owner);
+    if (found == owned.end()) return;
+
+    const std::vector<Id> ids = found->second;
+    for (Id id: ids) Erase(id);
+}
+
+void CoroutineScheduler::Update() {
+    assert(OwnThread() && "A scheduler is updated from the thread that created it");
+    now += Time::DeltaTime();
+
+    ready.clear();
+    timers.Advance(static_cast<std::uint64_t>(now / resolution), [this](Id id) {
+        // Stopped coroutines leave their timer behind.
+        const auto found = coroutines.find(id);
+        if (found == coroutines.end()) return;
+        found->second.sleeping = false;
+        --sleepingCount;
+        ready.push_back(id);
+    });
+    ready.insert(ready.end(), nextFrame.begin(), nextFrame.end());
+    nextFrame.clear();
+
+    std::size_t kept = 0;
+    for (const auto &waiting: polled) {
+        if (coroutines.count(waiting.first) == 0) continue;
+        if ((*waiting.second)()) {
+            ready.push_back(waiting.first);
+        } else {
+            polled[kept++] = waiting;
+        }
+    }
+    polled.resize(kept);
+
+    // Coroutines resumed here that wait again are parked for a later frame, not this list.
+    for (std::size_t i = 0; i < ready.size(); ++i) {
+        try {
+            Resume(ready[i]);
+        } catch (...) {
+            nextFrame.insert(nextFrame.end(), ready.begin() + static_cast<std::ptrdiff_t>(i) + 1, ready.end());
+            throw;
+        }
+    }
+}
+
+CoroutineScheduler &CoroutineScheduler::Shared() {
+    static CoroutineScheduler shared {0.001, true};
+    return shared;
+}
+
+void CoroutineScheduler::StopShared(const BehaviourScript &owner) {
+    Shared().StopAll(owner);
+}
+
+void CoroutineScheduler::Resume(Id id) {
+    const auto found = coroutines.find(id);
+    if (found == coroutines.end()) return;
+
+    const Coroutine::Handle handle = found->second.handle;
+    Coroutine::promise_type &promise = handle.promise();
+    promise.resuming = true;
+    handle.resume();
+    promise.resuming = false;
+
+    if (handle.done() || promise.stopped) {
+        const std::exception_ptr exception = promise.exception;
+        Erase(id);
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+void CoroutineScheduler::Erase(Id id) {
+    const auto found = coroutines.find(id);
+    if (found == coroutines.end()) return;
+
+    // A coroutine stopping itself, or its caller, is destroyed once it suspends.
+    const Entry entry = found->second;
+    if (entry.handle.promise().resuming) {
+        entry.handle.promise().stopped = true;
+        return;
+    }
+
+    if (entry.sleeping) --sleepingCount;
+    coroutines.erase(found);
+    std::vector<Id> &ids = owned[entry.owner];
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+    if (ids.empty()) owned.erase(entry.owner);
+    entry.handle.destroy();
+}
+
+void WaitForSeconds::await_suspend(Coroutine::Handle handle) const {
+    CoroutineScheduler &scheduler = *handle.promise().scheduler;
+    const double due = std::ceil((scheduler.now + seconds) / scheduler.resolution);
+    scheduler.timers.Schedule(static_cast<std::uint64_t>(std::max(due, 0.0)), handle.promise().id);
+    scheduler.coroutines.at(handle.promise().id).sleeping = true;
+    ++scheduler.sleepingCount;
+}
+
+void WaitForNextFrame::await_suspend(Coroutine::Handle handle) const {
+    handle.promise().scheduler->nextFrame.push_back(handle.promise().id);
+}
+
+void WaitUntil::await_suspend(Coroutine::Handle handle) const {
+    handle.promise().scheduler->polled.emplace_back(handle.promise().id, &condition);
+}
+
+#endif // SPIC_COROUTINES
@@ -0,0 +1,231 @@
+#ifndef COROUTINE_H_
+#define COROUTINE_H_
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define SPIC_COROUTINES
+#endif
+#endif
+
+#ifdef SPIC_COROUTINES
+
+#include "TimerWheel.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace spic {
+
+    class BehaviourScript;
+
+    class CoroutineScheduler;
+
+    /**
+     * @brief The return type of script methods that wait, written as C++20 coroutines.
+     * @details A Coroutine does nothing until it is passed to BehaviourScript::StartCoroutine,
+     *          which runs it up to its first co_await. For example:
+     *          @code
+     *          Coroutine Explode() {
+     *              co_await WaitForSeconds {2.0};
+     *              // ...
+     *          }
+     *          @endcode
+     */
+    class Coroutine {
+    public:
+        struct promise_type {
+            CoroutineScheduler *scheduler {nullptr};
+            std::uint64_t id {0};
+            std::exception_ptr exception;
+            bool resuming {false};
+            bool stopped {false};
+
+            Coroutine get_return_object() { return Coroutine {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            void return_void() {}
+
+            void unhandled_exception() { exception = std::current_exception(); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Coroutine(Coroutine &&other) noexcept : handle {std::exchange(other.handle, nullptr)} {}
+
+        Coroutine &operator=(Coroutine &&other) noexcept;
+
+        ~Coroutine();
+
+        /**
+         * @brief Give up ownership of the coroutine frame.
+         */
+        Handle Release() { return std::exchange(handle, nullptr); }
+
+    private:
+        explicit Coroutine(Handle handle) : handle {handle} {}
+
+        Handle handle;
+    };
+
+    /**
+     * @brief Resumes coroutines when what they wait for has happened.
+     * @details Coroutines waiting for time are parked in a TimerWheel of game time, so a
+     *          suspended coroutine costs nothing per frame until it is due. Only coroutines
+     *          waiting for the next frame, and those polling a WaitUntil condition, are looked
+     *          at every frame. A scheduler is not thread-safe: it must only be used from the
+     *          thread that created it, which for Shared() is the main thread. Debug builds
+     *          assert this.
+     */
+    class CoroutineScheduler {
+    public:
+        using Id = std::uint64_t;
+
+        /**
+         * @brief Constructor.
+         * @param resolution The length of one timer tick, in seconds. Waits are rounded up to it.
+         */
+        explicit CoroutineScheduler(double resolution = 0.001) : CoroutineScheduler(resolution, false) {}
+
+        /**
+         * @brief Destroys every coroutine that has not finished.
+         */
+        ~CoroutineScheduler();
+
+        CoroutineScheduler(const CoroutineScheduler &other) = delete;
+
+        CoroutineScheduler &operator=(const CoroutineScheduler &other) = delete;
+
+        /**
+         * @brief Run a coroutine up to its first co_await.
+         * @param owner The script whose StopAll stops the coroutine.
+         * @return An id for Stop, or 0 if the coroutine finished without waiting.
+         * @exception Exceptions escaping the coroutine are rethrown.
+         */
+        Id Start(const BehaviourScript &owner, Coroutine coroutine);
+
+        /**
+         * @brief Destroy a coroutine that has not finished; does nothing otherwise.
+         */
+        void Stop(Id id);
+
+        /**
+         * @brief Destroy the unfinished coroutines of a script.
+         */
+        void StopAll(const BehaviourScript &owner);
+
+        /**
+         * @brief Advance game time by Time::DeltaTime() and resume the coroutines that are due,
+         *        those waiting for this frame, and those whose WaitUntil condition holds.
+         * @exception Exceptions escaping a coroutine are rethrown after it is destroyed.
+         */
+        void Update();
+
+        /**
+         * @brief The number of unfinished coroutines.
+         */
+        [[nodiscard]] std::size_t Running() const { return coroutines.size(); }
+
+        /**
+         * @brief The number of unfinished coroutines waiting in WaitForSeconds. Stopped ones are
+         *        not counted, even while their timers are still parked in the wheel.
+         */
+        [[nodiscard]] std::size_t Sleeping() const { return sleepingCount; }
+
+        /**
+         * @brief The scheduler used by BehaviourScript::StartCoroutine.
+         */
+        static CoroutineScheduler &Shared();
+
+    private:
+        friend struct WaitForSeconds;
+        friend struct WaitForNextFrame;
+        friend struct WaitUntil;
+
+        struct Entry {
+            Coroutine::Handle handle;
+            const BehaviourScript *owner;
+            bool sleeping {false};
+        };
+
+        /**
+         * @brief Constructor; the shared scheduler stops the coroutines of scripts being destroyed.
+         */
+        CoroutineScheduler(double resolution, bool shared);
+
+        static void StopShared(const BehaviourScript &owner);
+
+        /**
+         * @brief Whether the caller is on the thread that created the scheduler.
+         */
+        [[nodiscard]] bool OwnThread() const { return std::this_thread::get_id() == thread; }
+
+        void Resume(Id id);
+
+        void Erase(Id id);
+
+        double resolution;
+        bool shared;
+        std::thread::id thread;
+        double now {0};
+        Id nextId {1};
+        std::unordered_map<Id, Entry> coroutines;
+        std::unordered_map<const BehaviourScript *, std::vector<Id>> owned;
+        TimerWheel<Id> timers;
+        std::size_t sleepingCount {0};
+        std::vector<Id> nextFrame;
+        std::vector<std::pair<Id, const std::function<bool()> *>> polled;
+        std::vector<Id> ready;
+    };
+
+    /**
+     * @brief Suspend for an amount of scaled game time; see Time::TimeScale.
+     */
+    struct WaitForSeconds {
+        double seconds;
+
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+        void await_suspend(Coroutine::Handle handle) const;
+
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Suspend until the next CoroutineScheduler::Update.
+     */
+    struct WaitForNextFrame {
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+        void await_suspend(Coroutine::Handle handle) const;
+
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * @brief Suspend until a condition holds. The condition is checked once per frame, so
+     *        prefer WaitForSeconds when waiting for time.
+     */
+    struct WaitUntil {
+        std::function<bool()> condition;
+
+        [[nodiscard]] bool await_ready() const { return condition(); }
+
+        void await_suspend(Coroutine::Handle handle) const;
+
+        void await_resume() const noexcept {}
+    };
+
+}
+
+#endif // SPIC_COROUTINES
+
+#endif // COROUTINE_H_
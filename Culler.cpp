@@ -0,0 +1,38 @@
+#include "Culler.hpp"
+
+using namespace spic;
+
+Culler::Culler(double cellSize) : grid {cellSize} {}
+
+void Culler::Add(GameObject &gameObject, const Rect &bounds) {
+    const int id = grid.Insert(bounds);
+    if (static_cast<std::size_t>(id) >= objects.size()) objects.resize(id + 1);
+    objects[id] = &gameObject;
+    ids[&gameObject] = id;
+}
+
+void Culler::Move(const GameObject &gameObject, const Rect &bounds) {
+    auto found = ids.find(&gameObject);
+    if (found != ids.end()) grid.Update(found->second, bounds);
+}
+
+void Culler::Remove(const GameObject &gameObject) {
+    auto found = ids.find(&gameObject);
+    if (found == ids.end()) return;
+
+    grid.Remove(found->second);
+    objects[found->second] = nullptr;
+    ids.erase(found);
+}
+
+CullingStats Culler::Cull(const Camera &camera, std::vector<GameObject *> &visible) {
+    visible.clear();
+
+    grid.Query(camera.ViewRect(), [&](int id) {
+        GameObject *gameObject = objects[id];
+        if (gameObject->Active()) visible.push_back(gameObject);
+    });
+
+    stats = {grid.Size(), visible.size(), grid.Size() - visible.size()};
+    return stats;
+}
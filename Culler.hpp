@@ -0,0 +1,86 @@
+#ifndef CULLER_H_
+#define CULLER_H_
+
+#include "Camera.hpp"
+#include "GameObject.hpp"
+#include "SpatialGrid.hpp"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Counters describing one call to Culler::Cull.
+     */
+    struct CullingStats {
+        /**
+         * @brief The number of renderable objects known to the culler.
+         */
+        std::size_t registered;
+
+        /**
+         * @brief The number of objects that were inside the view.
+         */
+        std::size_t visible;
+
+        /**
+         * @brief The number of objects left out: outside the view or inactive.
+         */
+        std::size_t culled;
+    };
+
+    /**
+     * @brief Finds the renderable objects (those with a Sprite, and Text) inside a camera's view.
+     * @details The objects' world-space bounds are kept in a spatial grid, so culling only visits
+     *          the cells covered by the view instead of every object in Scene::contents.
+     */
+    class Culler {
+    public:
+        /**
+         * @brief Constructor.
+         * @param cellSize The cell size of the spatial grid in world units; about twice the size
+         *        of a typical object works well.
+         */
+        explicit Culler(double cellSize = 256);
+
+        /**
+         * @brief Register a renderable object.
+         * @param gameObject The object, which must stay alive until it is removed.
+         * @param bounds The world-space bounds of everything the object draws.
+         */
+        void Add(GameObject &gameObject, const Rect &bounds);
+
+        /**
+         * @brief Update the bounds of a registered object after it moved or resized.
+         */
+        void Move(const GameObject &gameObject, const Rect &bounds);
+
+        /**
+         * @brief Unregister an object.
+         */
+        void Remove(const GameObject &gameObject);
+
+        /**
+         * @brief Collect the active registered objects overlapping the camera's view.
+         * @param camera The camera to cull for.
+         * @param visible Receives the visible objects; it is cleared first.
+         * @return Statistics for this call, also available through LastStats().
+         */
+        CullingStats Cull(const Camera &camera, std::vector<GameObject *> &visible);
+
+        /**
+         * @brief The statistics of the most recent Cull, for per-frame reporting.
+         */
+        [[nodiscard]] const CullingStats &LastStats() const { return stats; }
+
+    private:
+        SpatialGrid grid;
+        std::vector<GameObject *> objects;
+        std::unordered_map<const GameObject *, int> ids;
+        CullingStats stats {0, 0, 0};
+    };
+
+}
+
+#endif // CULLER_H_
@@ -0,0 +1,27 @@
+#include "Debug.hpp"
+
+using namespace spic;
+
+void Debug::Log(const std::string &message) {
+#if SPIC_LOG_LEVEL <= 0
+    Logger::Shared().Write(LogLevel::info, message);
+#else
+    (void) message;
+#endif
+}
+
+void Debug::LogError(const std::string &error) {
+#if SPIC_LOG_LEVEL <= 2
+    Logger::Shared().Write(LogLevel::error, error);
+#else
+    (void) error;
+#endif
+}
+
+void Debug::LogWarning(const std::string &warning) {
+#if SPIC_LOG_LEVEL <= 1
+    Logger::Shared().Write(LogLevel::warning, warning);
+#else
+    (void) warning;
+#endif
+}
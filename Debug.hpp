@@ -3,6 +3,7 @@
 
 #include "Point.hpp"
 #include "Color.hpp"
+#include "Logger.hpp"
 #include <string>
 
 namespace spic {
@@ -23,6 +24,8 @@ namespace spic {
 
         /**
          * @brief Logs a message to the Console.
+         * @details Returns right away; the message is written by Logger::Shared() on a background
+         *          thread. Use SPIC_LOG to have the call compiled out below SPIC_LOG_LEVEL.
          * @param message The message to write.
          * @spicapi
          */
@@ -0,0 +1,88 @@
+#include "GameLoop.hpp"
+#include "Time.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief The part of a capped frame spent spinning instead of sleeping, in seconds.
+     */
+    constexpr double spinTime = 0.002;
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+}
+
+GameLoop::GameLoop(FixedUpdate fixedUpdate, Render render, int maxSteps)
+    : fixedUpdate {std::move(fixedUpdate)}, render {std::move(render)}, maxSteps {std::max(maxSteps, 1)} {}
+
+int GameLoop::Frame() {
+    if (!externalClock) Time::Tick();
+
+    const double step = Time::FixedDeltaTime();
+    accumulator += Time::DeltaTime();
+
+    int steps = 0;
+    while (accumulator >= step && steps < maxSteps) {
+        Time::fixedUpdating = true;
+        try {
+            fixedUpdate();
+        } catch (...) {
+            Time::fixedUpdating = false;
+            throw;
+        }
+        Time::fixedUpdating = false;
+        accumulator -= step;
+        ++steps;
+    }
+
+    if (accumulator >= step) {
+        // Spiral of death guard: keep only the fraction of a step, so the next frame starts fresh.
+        const double kept = std::fmod(accumulator, step);
+        droppedTime += accumulator - kept;
+        accumulator = kept;
+    }
+
+    render(accumulator / step);
+    if (!externalClock && frameRateCap > 0) Wait();
+    return steps;
+}
+
+void GameLoop::Run(const bool &running) {
+    while (running) Frame();
+}
+
+void GameLoop::FrameRateCap(double framesPerSecond) {
+    frameRateCap = framesPerSecond;
+    deadline = 0;
+}
+
+void GameLoop::ExternalClock(bool external) {
+    externalClock = external;
+}
+
+void GameLoop::Wait() {
+    const double interval = 1 / frameRateCap;
+    const double now = Now();
+
+    // Deadlines follow each other at exact intervals, so sleeping too long once is made up for
+    // by the next frame. A frame that was already too slow does not wait, and starts over.
+    deadline = deadline == 0 ? now + interval : deadline + interval;
+    if (now >= deadline) {
+        deadline = now;
+        return;
+    }
+
+    if (deadline - now > spinTime) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(deadline - now - spinTime));
+    }
+    while (Now() < deadline) std::this_thread::yield();
+}
@@ -0,0 +1,93 @@
+#ifndef GAMELOOP_H_
+#define GAMELOOP_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace spic {
+
+    /**
+     * @brief Runs simulation at a fixed rate and rendering once per frame.
+     * @details Every Frame ticks Time, adds the scaled delta time to an accumulator, and runs
+     *          fixed updates of Time::FixedDeltaTime while the accumulator holds a whole step.
+     *          When a frame would need more than maxSteps steps, as after a hitch, the rest of
+     *          the backlog is dropped instead of falling further behind each frame. Rendering
+     *          gets how far the simulation is into the next step, for interpolation. Frames can
+     *          be capped to a rate: the loop sleeps for most of the remaining time and spins for
+     *          the last bit, since sleeping alone overshoots by up to a scheduler tick.
+     */
+    class GameLoop {
+    public:
+        /**
+         * @brief Advances the simulation by Time::FixedDeltaTime.
+         * @details Time::DeltaTime returns Time::FixedDeltaTime while it runs, so code shared with
+         *          per frame updates moves by the step.
+         */
+        using FixedUpdate = std::function<void()>;
+
+        /**
+         * @brief Draws a frame.
+         * @details Called with alpha, 0 ≤ alpha < 1, the fraction of a fixed step the simulation
+         *          has yet to run.
+         */
+        using Render = std::function<void(double alpha)>;
+
+        /**
+         * @brief Constructor.
+         * @param fixedUpdate Called for every fixed step.
+         * @param render Called once per frame.
+         * @param maxSteps The highest number of fixed steps in one frame, at least 1.
+         */
+        GameLoop(FixedUpdate fixedUpdate, Render render, int maxSteps = 5);
+
+        /**
+         * @brief Run one frame.
+         * @return The number of fixed steps run.
+         */
+        int Frame();
+
+        /**
+         * @brief Run frames until running is false.
+         */
+        void Run(const bool &running);
+
+        /**
+         * @brief Limit the frame rate, or 0 for no limit. Has no effect with ExternalClock.
+         */
+        void FrameRateCap(double framesPerSecond);
+
+        [[nodiscard]] double FrameRateCap() const { return frameRateCap; }
+
+        /**
+         * @brief Take the delta time from whoever calls Time::Tick before each Frame, such as an
+         *        InputPlayer, instead of measuring it, and never sleep.
+         */
+        void ExternalClock(bool external);
+
+        [[nodiscard]] bool ExternalClock() const { return externalClock; }
+
+        /**
+         * @brief The game time dropped so far because frames needed more than maxSteps steps.
+         */
+        [[nodiscard]] double DroppedTime() const { return droppedTime; }
+
+    private:
+        void Wait();
+
+        FixedUpdate fixedUpdate;
+        Render render;
+        int maxSteps;
+        double accumulator {0};
+        double droppedTime {0};
+        double frameRateCap {0};
+        bool externalClock {false};
+
+        /**
+         * @brief When the current frame should end with a frame rate cap, in seconds of the clock.
+         */
+        double deadline {0};
+    };
+
+}
+
+#endif // GAMELOOP_H_
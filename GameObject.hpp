@@ -2,6 +2,7 @@
 #define GAMEOBJECT_H_
 
 #include "Component.hpp"
+#include "Transform.hpp"
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -302,6 +303,18 @@ namespace spic {
 
         [[nodiscard]] int Layer() const;
 
+        /**
+         * @brief The position, rotation and scale of the GameObject in the world.
+         * @param newTransform The new transform.
+         */
+        void TransformValue(const Transform &newTransform) { transform = newTransform; }
+
+        /**
+         * @brief The position, rotation and scale of the GameObject in the world.
+         * @return The current transform.
+         */
+        [[nodiscard]] const Transform &TransformValue() const { return transform; }
+
         [[nodiscard]] int Id() const { return id; }
 
         void Id(int newId) { id = newId; }
@@ -314,6 +327,7 @@ namespace spic {
         static std::vector<std::shared_ptr<GameObject>> gameObjects;
         std::vector<std::shared_ptr<Component>> components;
         std::shared_ptr<GameObject> parent;
+        Transform transform {{0, 0}, 0, 1};
         int id = -1;
     protected:
         template<class T>
@@ -0,0 +1,100 @@
+#include "GlyphAtlas.hpp"
+#include <algorithm>
+
+using namespace spic;
+
+GlyphAtlas::SourceFactory GlyphAtlas::factory;
+std::map<std::pair<std::string, int>, std::unique_ptr<GlyphAtlas>> GlyphAtlas::atlases;
+std::uint64_t GlyphAtlas::generation {1};
+
+namespace {
+
+    /**
+     * @brief Empty pixels kept around every glyph, against bleeding when filtering.
+     */
+    constexpr int padding = 1;
+
+    /**
+     * @brief The atlas stops growing at this height.
+     */
+    constexpr int maxHeight = 4096;
+
+}
+
+GlyphAtlas::GlyphAtlas(std::unique_ptr<IGlyphSource> source, int width)
+    : source {std::move(source)}, width {width}, height {width},
+      pixels(static_cast<std::size_t>(width) * width, 0) {}
+
+void GlyphAtlas::Sources(SourceFactory newFactory) {
+    factory = std::move(newFactory);
+}
+
+GlyphAtlas *GlyphAtlas::Get(const std::string &font, int size) {
+    auto key = std::make_pair(font, size);
+    auto found = atlases.find(key);
+    if (found != atlases.end()) return found->second.get();
+
+    if (!factory) return nullptr;
+    std::unique_ptr<IGlyphSource> source = factory(font, size);
+    if (source == nullptr) return nullptr;
+
+    return atlases.emplace(std::move(key), std::make_unique<GlyphAtlas>(std::move(source))).first->second.get();
+}
+
+void GlyphAtlas::Clear() {
+    atlases.clear();
+    ++generation;
+}
+
+const Glyph *GlyphAtlas::Find(char32_t codepoint) {
+    Glyph *slot;
+    if (codepoint < ascii.size()) {
+        slot = &ascii[codepoint];
+        if (asciiKnown[codepoint]) return slot->width < 0 ? nullptr : slot;
+        asciiKnown[codepoint] = true;
+    } else {
+        auto inserted = others.emplace(codepoint, Glyph {});
+        slot = &inserted.first->second;
+        if (!inserted.second) return slot->width < 0 ? nullptr : slot;
+    }
+
+    GlyphBitmap bitmap {};
+    int x = 0;
+    int y = 0;
+    if (!source->Rasterize(codepoint, bitmap) || !Allocate(bitmap.width, bitmap.height, x, y)) {
+        slot->width = -1;
+        return nullptr;
+    }
+
+    for (int row = 0; row < bitmap.height; ++row) {
+        std::copy_n(bitmap.coverage.begin() + static_cast<std::ptrdiff_t>(row) * bitmap.width, bitmap.width,
+                    pixels.begin() + static_cast<std::ptrdiff_t>(y + row) * width + x);
+    }
+
+    *slot = {x, y, bitmap.width, bitmap.height, bitmap.bearingX, bitmap.bearingY, bitmap.advance};
+    ++revision;
+    return slot;
+}
+
+bool GlyphAtlas::Allocate(int glyphWidth, int glyphHeight, int &x, int &y) {
+    if (glyphWidth + padding > width) return false;
+
+    if (shelfX + glyphWidth + padding > width) {
+        shelfY += shelfHeight;
+        shelfX = 0;
+        shelfHeight = 0;
+    }
+
+    while (shelfY + glyphHeight + padding > height) {
+        if (height * 2 > maxHeight) return false;
+        // Rows are appended, so everything already placed keeps its coordinates.
+        height *= 2;
+        pixels.resize(static_cast<std::size_t>(width) * height, 0);
+    }
+
+    x = shelfX;
+    y = shelfY;
+    shelfX += glyphWidth + padding;
+    shelfHeight = std::max(shelfHeight, glyphHeight + padding);
+    return true;
+}
@@ -0,0 +1,179 @@
+#ifndef GLYPHATLAS_H_
+#define GLYPHATLAS_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief A glyph as produced by a font rasterizer.
+     */
+    struct GlyphBitmap {
+        int width;
+        int height;
+
+        /**
+         * @brief Offset from the pen position to the left edge of the bitmap.
+         */
+        int bearingX;
+
+        /**
+         * @brief Offset from the baseline up to the top edge of the bitmap.
+         */
+        int bearingY;
+
+        /**
+         * @brief How far the pen moves right after this glyph.
+         */
+        int advance;
+
+        /**
+         * @brief One byte of coverage per pixel, row by row, 255 is fully covered.
+         */
+        std::vector<std::uint8_t> coverage;
+    };
+
+    /**
+     * @brief Interface for font rasterizers feeding a GlyphAtlas, implemented by the engine on
+     *        top of its font library.
+     */
+    class IGlyphSource {
+    public:
+        virtual ~IGlyphSource() = default;
+
+        /**
+         * @brief Rasterize one character.
+         * @param codepoint The Unicode code point.
+         * @param bitmap Receives the glyph.
+         * @return false if the font has no glyph for the code point.
+         */
+        virtual bool Rasterize(char32_t codepoint, GlyphBitmap &bitmap) = 0;
+
+        /**
+         * @brief The distance between the baselines of two lines, in pixels.
+         */
+        virtual int LineHeight() const = 0;
+
+        /**
+         * @brief The distance from the top of a line to its baseline, in pixels.
+         */
+        virtual int Ascent() const = 0;
+    };
+
+    /**
+     * @brief Where a glyph is stored in a GlyphAtlas, plus its metrics.
+     */
+    struct Glyph {
+        int x;
+        int y;
+        int width;
+        int height;
+        int bearingX;
+        int bearingY;
+        int advance;
+    };
+
+    /**
+     * @brief All glyphs of one font at one size, rasterized once on first use and stored in a
+     *        single coverage texture, so a whole Text can be drawn as one batch of quads.
+     * @details Glyphs are placed on shelves (rows as high as their tallest glyph). When the
+     *          texture is full it doubles in height; glyphs already placed keep their position.
+     */
+    class GlyphAtlas {
+    public:
+        using SourceFactory = std::function<std::unique_ptr<IGlyphSource>(const std::string &font, int size)>;
+
+        /**
+         * @brief Constructor.
+         * @param source The rasterizer of the font.
+         * @param width The width of the atlas texture in pixels; also its initial height.
+         */
+        explicit GlyphAtlas(std::unique_ptr<IGlyphSource> source, int width = 512);
+
+        /**
+         * @brief Register how atlases for Get are created.
+         */
+        static void Sources(SourceFactory factory);
+
+        /**
+         * @brief The shared atlas of a font at a size, created on first use.
+         * @return The atlas, or nullptr if no SourceFactory is registered or it failed.
+         */
+        static GlyphAtlas *Get(const std::string &font, int size);
+
+        /**
+         * @brief Drop all shared atlases. Layouts referring to them become stale; see Generation.
+         */
+        static void Clear();
+
+        /**
+         * @brief A number that changes on every Clear, so layouts can tell whether the shared
+         *        atlas they refer to still exists.
+         */
+        [[nodiscard]] static std::uint64_t Generation() { return generation; }
+
+        /**
+         * @brief Look up a glyph, rasterizing and storing it on first use.
+         * @return The glyph, or nullptr if the font has none for this code point. The pointer
+         *         stays valid for the lifetime of the atlas.
+         */
+        const Glyph *Find(char32_t codepoint);
+
+        [[nodiscard]] int LineHeight() const { return source->LineHeight(); }
+
+        [[nodiscard]] int Ascent() const { return source->Ascent(); }
+
+        [[nodiscard]] int Width() const { return width; }
+
+        [[nodiscard]] int Height() const { return height; }
+
+        /**
+         * @brief The coverage texture, Width() × Height() bytes.
+         */
+        [[nodiscard]] const std::vector<std::uint8_t> &Pixels() const { return pixels; }
+
+        /**
+         * @brief Increases whenever glyphs are added, so a copy on the GPU can be refreshed.
+         */
+        [[nodiscard]] std::uint32_t Revision() const { return revision; }
+
+    private:
+        bool Allocate(int glyphWidth, int glyphHeight, int &x, int &y);
+
+        std::unique_ptr<IGlyphSource> source;
+        int width;
+        int height;
+        std::vector<std::uint8_t> pixels;
+        std::uint32_t revision {0};
+
+        /**
+         * @brief The current shelf: its top row, height, and the first free column.
+         */
+        int shelfY {0};
+        int shelfHeight {0};
+        int shelfX {0};
+
+        /**
+         * @brief Glyphs for ASCII in a flat table, everything else in a map.
+         * @details A missing glyph is remembered with width -1 so it is not rasterized again.
+         */
+        std::array<Glyph, 128> ascii {};
+        std::array<bool, 128> asciiKnown {};
+        std::unordered_map<char32_t, Glyph> others;
+
+        static SourceFactory factory;
+        static std::map<std::pair<std::string, int>, std::unique_ptr<GlyphAtlas>> atlases;
+        static std::uint64_t generation;
+    };
+
+}
+
+#endif // GLYPHATLAS_H_
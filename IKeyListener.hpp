@@ -1,10 +1,20 @@
 #ifndef IKEYLISTENER_H_
 #define IKEYLISTENER_H_
 
+#include "Input.hpp"
+
 namespace spic {
 
+    /**
+     * @brief A key that was pressed or released.
+     */
+    struct KeyEvent {
+        Input::KeyCode key;
+    };
+
     /**
      * @brief Interface for objects wanting to respond to keyboard events.
+     * @details Listeners are called by an InputDispatcher, only for the keys they subscribed to.
      */
     class IKeyListener {
     public:
@@ -21,6 +31,16 @@ namespace spic {
          * @spicapi
          */
         virtual void OnKeyReleased() = 0;
+
+        /**
+         * @brief Called whenever a subscribed key is pressed; calls OnKeyPressed() unless overridden.
+         */
+        virtual void OnKeyPressed(const KeyEvent &) { OnKeyPressed(); }
+
+        /**
+         * @brief Called whenever a subscribed key is released; calls OnKeyReleased() unless overridden.
+         */
+        virtual void OnKeyReleased(const KeyEvent &) { OnKeyReleased(); }
     };
 
 }
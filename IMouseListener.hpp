@@ -1,10 +1,36 @@
 #ifndef IMOUSELISTENER_H_
 #define IMOUSELISTENER_H_
 
+#include "Input.hpp"
+#include "Point.hpp"
+
 namespace spic {
 
+    /**
+     * @brief A mouse move or a change of a mouse button.
+     */
+    struct MouseEvent {
+        /**
+         * @brief The mouse position in pixel coordinates.
+         */
+        Point position;
+
+        /**
+         * @brief How far the mouse moved since the last move event; zero for button events.
+         */
+        Point delta;
+
+        /**
+         * @brief The button; unused for moves.
+         */
+        Input::MouseButton button;
+    };
+
     /**
      * @brief Interface for objects wanting to respond to mouse events.
+     * @details Listeners are called by an InputDispatcher, only for the buttons they subscribed
+     *          to, or for moves. The overloads taking a MouseEvent call the ones without unless
+     *          overridden.
      */
     class IMouseListener {
     public:
@@ -31,6 +57,17 @@ namespace spic {
          * @spicapi
          */
         virtual void OnMouseReleased() = 0;
+
+        /**
+         * @brief Called at most once per frame when the mouse moved, with where it ended up.
+         */
+        virtual void OnMouseMoved(const MouseEvent &) { OnMouseMoved(); }
+
+        virtual void OnMouseClicked(const MouseEvent &) { OnMouseClicked(); }
+
+        virtual void OnMousePressed(const MouseEvent &) { OnMousePressed(); }
+
+        virtual void OnMouseReleased(const MouseEvent &) { OnMouseReleased(); }
     };
 
 }
@@ -0,0 +1,207 @@
+#include "Input.hpp"
+#include "SpscRing.hpp"
+#include <array>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPIC_INPUT_SSE2
+#endif
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief One bit per KeyCode.
+     */
+    struct KeyBits {
+        alignas(16) std::array<std::uint64_t, 4> words;
+
+        [[nodiscard]] bool Test(unsigned int key) const { return (words[key >> 6] >> (key & 63)) & 1; }
+
+        void Set(unsigned int key, bool value) {
+            const std::uint64_t bit = std::uint64_t {1} << (key & 63);
+            words[key >> 6] = value ? words[key >> 6] | bit : words[key >> 6] & ~bit;
+        }
+    };
+
+    /**
+     * @brief Whether any bit is set in set and not in mask.
+     */
+    bool AnyExcept(const KeyBits &set, const KeyBits &mask) {
+#ifdef SPIC_INPUT_SSE2
+        const auto *a = reinterpret_cast<const __m128i *>(set.words.data());
+        const auto *b = reinterpret_cast<const __m128i *>(mask.words.data());
+        const __m128i bits = _mm_or_si128(_mm_andnot_si128(_mm_load_si128(b), _mm_load_si128(a)),
+                                          _mm_andnot_si128(_mm_load_si128(b + 1), _mm_load_si128(a + 1)));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) != 0xFFFF;
+#else
+        return ((set.words[0] & ~mask.words[0]) | (set.words[1] & ~mask.words[1]) |
+                (set.words[2] & ~mask.words[2]) | (set.words[3] & ~mask.words[3])) != 0;
+#endif
+    }
+
+    constexpr KeyBits noKeys {};
+
+    KeyBits keys {};
+    KeyBits previousKeys {};
+    std::uint8_t buttons {0};
+    std::uint8_t previousButtons {0};
+    Point mouse {0, 0};
+
+    SpscRing<Input::InputEvent> events {1024};
+
+    /**
+     * @brief An event held back to the next Update, see Input::Update.
+     */
+    Input::InputEvent deferred {};
+    bool hasDeferred {false};
+
+    /**
+     * @brief The events applied by the last Update; at most the queue's capacity plus the
+     *        deferred one.
+     */
+    std::array<Input::InputEvent, 1025> applied {};
+    std::size_t appliedCount {0};
+
+    unsigned int Code(Input::KeyCode key) {
+        return static_cast<unsigned int>(key) & 0xFF;
+    }
+
+    std::uint8_t Bit(Input::MouseButton which) {
+        return static_cast<std::uint8_t>(1u << static_cast<unsigned int>(which));
+    }
+
+    /**
+     * @brief Apply an event, unless it changes a key or button that already changed this frame.
+     * @return false if the event was not applied.
+     */
+    bool Apply(const Input::InputEvent &event, KeyBits &changedKeys, std::uint8_t &changedButtons) {
+        if (appliedCount == applied.size()) return false;
+
+        const std::uint8_t button = static_cast<std::uint8_t>(1u << (event.code & 7));
+        switch (event.type) {
+            case Input::EventType::keyDown:
+            case Input::EventType::keyUp:
+                if (changedKeys.Test(event.code)) return false;
+                changedKeys.Set(event.code, true);
+                keys.Set(event.code, event.type == Input::EventType::keyDown);
+                break;
+            case Input::EventType::buttonDown:
+            case Input::EventType::buttonUp:
+                if (changedButtons & button) return false;
+                changedButtons |= button;
+                buttons = event.type == Input::EventType::buttonDown ? buttons | button : buttons & ~button;
+                break;
+            case Input::EventType::mouseMove:
+                mouse = event.position;
+                break;
+        }
+        applied[appliedCount++] = event;
+        return true;
+    }
+
+}
+
+bool Input::PushEvent(const InputEvent &event) {
+    return events.Push(event);
+}
+
+void Input::Update() {
+    previousKeys = keys;
+    previousButtons = buttons;
+
+    KeyBits changedKeys {};
+    std::uint8_t changedButtons = 0;
+    appliedCount = 0;
+    if (hasDeferred) {
+        Apply(deferred, changedKeys, changedButtons);
+        hasDeferred = false;
+    }
+
+    // Only take what was queued when the frame started, so a flood of events cannot stall it.
+    InputEvent event {};
+    for (std::size_t pending = events.Size(); pending > 0 && events.Pop(event); --pending) {
+        if (!Apply(event, changedKeys, changedButtons)) {
+            // The rest stays queued behind it, so the order of events is kept.
+            deferred = event;
+            hasDeferred = true;
+            break;
+        }
+    }
+}
+
+Input::InputState Input::State() {
+    return {keys.words, buttons, mouse};
+}
+
+void Input::Replay(const InputState &state) {
+    previousKeys = keys;
+    previousButtons = buttons;
+    keys.words = state.keys;
+    buttons = state.buttons;
+
+    appliedCount = 0;
+    // The move comes first, so a click recorded after moving is replayed at the new position.
+    if (state.mouse.x != mouse.x || state.mouse.y != mouse.y) {
+        applied[appliedCount++] = {EventType::mouseMove, 0, state.mouse};
+        mouse = state.mouse;
+    }
+    for (unsigned int key = 0; key < 256; ++key) {
+        if (keys.Test(key) != previousKeys.Test(key)) {
+            applied[appliedCount++] = {keys.Test(key) ? EventType::keyDown : EventType::keyUp,
+                                       static_cast<std::uint8_t>(key), {0, 0}};
+        }
+    }
+    for (unsigned int button = 1; button <= 3; ++button) {
+        const auto bit = static_cast<std::uint8_t>(1u << button);
+        if ((buttons ^ previousButtons) & bit) {
+            applied[appliedCount++] = {buttons & bit ? EventType::buttonDown : EventType::buttonUp,
+                                       static_cast<std::uint8_t>(button), {0, 0}};
+        }
+    }
+}
+
+std::size_t Input::EventCount() {
+    return appliedCount;
+}
+
+const Input::InputEvent &Input::Event(std::size_t index) {
+    return applied[index];
+}
+
+bool Input::AnyKey() {
+    return buttons != 0 || AnyExcept(keys, noKeys);
+}
+
+bool Input::AnyKeyDown() {
+    return (buttons & ~previousButtons) != 0 || AnyExcept(keys, previousKeys);
+}
+
+Point Input::MousePosition() {
+    return mouse;
+}
+
+bool Input::GetKey(KeyCode key) {
+    return keys.Test(Code(key));
+}
+
+bool Input::GetKeyDown(KeyCode key) {
+    return keys.Test(Code(key)) && !previousKeys.Test(Code(key));
+}
+
+bool Input::GetKeyUp(KeyCode key) {
+    return !keys.Test(Code(key)) && previousKeys.Test(Code(key));
+}
+
+bool Input::GetMouseButton(MouseButton which) {
+    return (buttons & Bit(which)) != 0;
+}
+
+bool Input::GetMouseButtonDown(MouseButton which) {
+    return (buttons & ~previousButtons & Bit(which)) != 0;
+}
+
+bool Input::GetMouseButtonUp(MouseButton which) {
+    return (~buttons & previousButtons & Bit(which)) != 0;
+}
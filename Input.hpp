@@ -2,12 +2,20 @@
 #define INPUT_H_
 
 #include "Point.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace spic {
 
     /**
      * @brief Some convenient input functions.
+     * @details The state of all keys is kept as two 256-bit sets, for the current and the
+     *          previous frame, so queries are single bit tests and AnyKey and AnyKeyDown compare
+     *          a few words at once, with SSE2 when the compiler targets it. The thread receiving
+     *          events from the operating system hands them over through PushEvent, a lock-free
+     *          queue, and Update applies them once per frame. Queries never lock or allocate.
      */
     namespace Input {
 
@@ -269,6 +277,82 @@ namespace spic {
             RIGHT = 3
         };
 
+        /**
+         * @brief The kinds of InputEvent.
+         */
+        enum class EventType : std::uint8_t {
+            keyDown,
+            keyUp,
+            buttonDown,
+            buttonUp,
+            mouseMove
+        };
+
+        /**
+         * @brief A key, button or mouse move as received from the operating system.
+         */
+        struct InputEvent {
+            EventType type;
+
+            /**
+             * @brief The KeyCode or MouseButton; unused for mouseMove.
+             */
+            std::uint8_t code;
+
+            /**
+             * @brief The new mouse position for mouseMove.
+             */
+            Point position;
+        };
+
+        /**
+         * @brief Queue an event for the next Update. Call from the one thread receiving events
+         *        from the operating system; never blocks.
+         * @return false if the queue is full and the event was dropped.
+         */
+        bool PushEvent(const InputEvent &event);
+
+        /**
+         * @brief Make the current state the previous one and apply the queued events. Called by
+         *        the engine once at the start of every frame.
+         * @details When a key or button changes twice within one frame, the second change waits
+         *          for the next Update, so a short tap still shows up in GetKeyDown and GetKeyUp.
+         */
+        void Update();
+
+        /**
+         * @brief Everything the queries answer from: the pressed keys, one bit per KeyCode, the
+         *        pressed mouse buttons, one bit per MouseButton, and the mouse position.
+         */
+        struct InputState {
+            std::array<std::uint64_t, 4> keys;
+            std::uint8_t buttons;
+            Point mouse;
+        };
+
+        /**
+         * @brief The state as of the last Update.
+         */
+        InputState State();
+
+        /**
+         * @brief Use a recorded state instead of Update, for replays. The queued events are left
+         *        alone; the events of the frame are derived from what changed: the mouse move
+         *        first, then the keys, then the mouse buttons.
+         */
+        void Replay(const InputState &state);
+
+        /**
+         * @brief The number of events applied by the last Update.
+         */
+        std::size_t EventCount();
+
+        /**
+         * @brief An event applied by the last Update, in the order they happened.
+         * @param index 0 ≤ index < EventCount().
+         */
+        const InputEvent &Event(std::size_t index);
+
         /**
          * @brief Is any key or mouse button currently held down? (Read Only)
          * @spicapi
@@ -0,0 +1,122 @@
+#include "InputDispatcher.hpp"
+
+using namespace spic;
+
+InputDispatcher::Subscription InputDispatcher::Subscribe(Input::KeyCode key, IKeyListener &listener) {
+    return Add(static_cast<std::size_t>(key) & 0xFF, &listener);
+}
+
+InputDispatcher::Subscription InputDispatcher::Subscribe(Input::MouseButton button, IMouseListener &listener) {
+    return Add(buttonTables + (static_cast<std::size_t>(button) & 3), &listener);
+}
+
+InputDispatcher::Subscription InputDispatcher::SubscribeMoves(IMouseListener &listener) {
+    return Add(moveTable, &listener);
+}
+
+void InputDispatcher::Unsubscribe(Subscription subscription) {
+    if (dispatching) {
+        // Stop calling it right away, in case the listener is about to be destroyed.
+        const Location location = subscriptions[subscription];
+        if (location.table != ~0u) tables[location.table][location.index].listener = nullptr;
+        pendingRemovals.push_back(subscription);
+    } else {
+        Remove(subscription);
+    }
+}
+
+void InputDispatcher::Dispatch() {
+    dispatching = true;
+
+    // Listeners are called by index up to the size at the start, so they may subscribe others.
+    auto notify = [this](std::size_t table, auto call) {
+        const std::size_t count = tables[table].size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (tables[table][i].listener != nullptr) call(tables[table][i].listener);
+        }
+    };
+
+    // Button events report where the mouse was when they happened, not where the frame ended.
+    Point position = lastMouse;
+    bool moved = false;
+    for (std::size_t i = 0; i < Input::EventCount(); ++i) {
+        const Input::InputEvent &event = Input::Event(i);
+        const std::size_t button = buttonTables + (event.code & 3);
+        const auto which = static_cast<Input::MouseButton>(event.code & 3);
+
+        switch (event.type) {
+            case Input::EventType::keyDown:
+            case Input::EventType::keyUp: {
+                const KeyEvent keyEvent {static_cast<Input::KeyCode>(event.code)};
+                const bool down = event.type == Input::EventType::keyDown;
+                notify(event.code, [&](void *listener) {
+                    auto *keyListener = static_cast<IKeyListener *>(listener);
+                    down ? keyListener->OnKeyPressed(keyEvent) : keyListener->OnKeyReleased(keyEvent);
+                });
+                break;
+            }
+            case Input::EventType::buttonDown:
+                notify(button, [&](void *listener) {
+                    static_cast<IMouseListener *>(listener)->OnMouseClicked({position, {0, 0}, which});
+                });
+                break;
+            case Input::EventType::buttonUp:
+                notify(button, [&](void *listener) {
+                    static_cast<IMouseListener *>(listener)->OnMouseReleased({position, {0, 0}, which});
+                });
+                break;
+            case Input::EventType::mouseMove:
+                position = event.position;
+                moved = true;
+                break;
+        }
+    }
+
+    if (moved) {
+        const MouseEvent move {position, {position.x - lastMouse.x, position.y - lastMouse.y}, Input::MouseButton::LEFT};
+        lastMouse = position;
+        notify(moveTable, [&](void *listener) { static_cast<IMouseListener *>(listener)->OnMouseMoved(move); });
+    }
+
+    for (const Input::MouseButton which: {Input::MouseButton::LEFT, Input::MouseButton::MIDDLE,
+                                          Input::MouseButton::RIGHT}) {
+        if (!Input::GetMouseButton(which)) continue;
+        const MouseEvent held {Input::MousePosition(), {0, 0}, which};
+        notify(buttonTables + static_cast<std::size_t>(which), [&](void *listener) {
+            static_cast<IMouseListener *>(listener)->OnMousePressed(held);
+        });
+    }
+
+    dispatching = false;
+    for (Subscription subscription: pendingRemovals) Remove(subscription);
+    pendingRemovals.clear();
+}
+
+InputDispatcher::Subscription InputDispatcher::Add(std::size_t table, void *listener) {
+    Subscription subscription;
+    if (freeSubscriptions.empty()) {
+        subscription = static_cast<Subscription>(subscriptions.size());
+        subscriptions.emplace_back();
+    } else {
+        subscription = freeSubscriptions.back();
+        freeSubscriptions.pop_back();
+    }
+
+    subscriptions[subscription] = {static_cast<std::uint32_t>(table), static_cast<std::uint32_t>(tables[table].size())};
+    tables[table].push_back({subscription, listener});
+    return subscription;
+}
+
+void InputDispatcher::Remove(Subscription subscription) {
+    const Location location = subscriptions[subscription];
+    if (location.table == ~0u) return;
+
+    // Move the last entry of the table into the gap.
+    std::vector<Entry> &table = tables[location.table];
+    table[location.index] = table.back();
+    subscriptions[table[location.index].subscription].index = location.index;
+    table.pop_back();
+
+    subscriptions[subscription].table = ~0u;
+    freeSubscriptions.push_back(subscription);
+}
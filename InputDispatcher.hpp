@@ -0,0 +1,97 @@
+#ifndef INPUTDISPATCHER_H_
+#define INPUTDISPATCHER_H_
+
+#include "IKeyListener.hpp"
+#include "IMouseListener.hpp"
+#include "Input.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Calls key and mouse listeners for the events of a frame, only for what they
+     *        subscribed to.
+     * @details Every key and mouse button has a table of its own listeners, so an event costs
+     *          one call per interested listener, and listeners of keys nobody touched cost
+     *          nothing. Mouse moves are merged into one event per frame. Subscriptions may be
+     *          added and removed from within a listener; removals take effect after Dispatch.
+     */
+    class InputDispatcher {
+    public:
+        using Subscription = std::uint32_t;
+
+        /**
+         * @brief Call a listener when a key is pressed or released.
+         * @return A handle for Unsubscribe.
+         */
+        Subscription Subscribe(Input::KeyCode key, IKeyListener &listener);
+
+        /**
+         * @brief Call a listener when a mouse button is clicked, held or released.
+         * @return A handle for Unsubscribe.
+         */
+        Subscription Subscribe(Input::MouseButton button, IMouseListener &listener);
+
+        /**
+         * @brief Call a listener when the mouse moves.
+         * @return A handle for Unsubscribe.
+         */
+        Subscription SubscribeMoves(IMouseListener &listener);
+
+        void Unsubscribe(Subscription subscription);
+
+        /**
+         * @brief Call the listeners for the events applied by the last Input::Update, then
+         *        OnMousePressed for every button still down. Called by the engine once per frame.
+         */
+        void Dispatch();
+
+        /**
+         * @brief The number of subscriptions.
+         */
+        [[nodiscard]] std::size_t Size() const { return subscriptions.size() - freeSubscriptions.size(); }
+
+    private:
+        /**
+         * @brief Key tables come first, then one table per mouse button, then the move table.
+         */
+        static constexpr std::size_t buttonTables = 256;
+        static constexpr std::size_t moveTable = buttonTables + 4;
+
+        /**
+         * @brief A listener, an IKeyListener or IMouseListener depending on its table; nullptr
+         *        once unsubscribed during Dispatch.
+         */
+        struct Entry {
+            Subscription subscription;
+            void *listener;
+        };
+
+        struct Location {
+            std::uint32_t table;
+            std::uint32_t index;
+        };
+
+        Subscription Add(std::size_t table, void *listener);
+
+        void Remove(Subscription subscription);
+
+        std::array<std::vector<Entry>, moveTable + 1> tables;
+
+        /**
+         * @brief Per subscription, where its entry is; table is ~0u for free handles.
+         */
+        std::vector<Location> subscriptions;
+        std::vector<Subscription> freeSubscriptions;
+
+        std::vector<Subscription> pendingRemovals;
+        bool dispatching {false};
+        Point lastMouse {0, 0};
+    };
+
+}
+
+#endif // INPUTDISPATCHER_H_
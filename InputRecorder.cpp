@@ -0,0 +1,115 @@
+#include "InputRecorder.hpp"
+#include "Time.hpp"
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+using namespace spic;
+
+namespace {
+
+    constexpr char magic[8] = {'S', 'P', 'I', 'C', 'I', 'N', 'P', 'T'};
+    constexpr std::size_t headerSize = sizeof(magic);
+
+    /**
+     * @brief The bits of a frame's change mask: one per word of the key set, then the buttons
+     *        and the mouse position.
+     */
+    constexpr std::uint8_t buttonsChanged = 1u << 4;
+    constexpr std::uint8_t mouseChanged = 1u << 5;
+
+    void Put(std::ofstream &out, std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) out.put(static_cast<char>(value >> (8 * i)));
+    }
+
+    void Put(std::ofstream &out, double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Put(out, bits);
+    }
+
+}
+
+InputRecorder::InputRecorder(const std::string &path) : out {path, std::ios::binary} {
+    if (!out) throw std::runtime_error("Cannot create '" + path + "'");
+    out.write(magic, sizeof(magic));
+}
+
+void InputRecorder::Capture() {
+    const Input::InputState state = Input::State();
+
+    std::uint8_t mask = 0;
+    for (std::size_t word = 0; word < state.keys.size(); ++word) {
+        if (state.keys[word] != previous.keys[word]) mask |= static_cast<std::uint8_t>(1u << word);
+    }
+    if (state.buttons != previous.buttons) mask |= buttonsChanged;
+    if (state.mouse.x != previous.mouse.x || state.mouse.y != previous.mouse.y) mask |= mouseChanged;
+
+    Put(out, Time::UnscaledDeltaTime());
+    out.put(static_cast<char>(mask));
+    for (std::size_t word = 0; word < state.keys.size(); ++word) {
+        if (mask & (1u << word)) Put(out, state.keys[word]);
+    }
+    if (mask & buttonsChanged) out.put(static_cast<char>(state.buttons));
+    if (mask & mouseChanged) {
+        Put(out, state.mouse.x);
+        Put(out, state.mouse.y);
+    }
+
+    previous = state;
+    ++frames;
+}
+
+InputPlayer::InputPlayer(const std::string &path, double fixedStep) : offset {headerSize}, fixedStep {fixedStep} {
+    std::ifstream in {path, std::ios::binary};
+    if (!in) throw std::runtime_error("Cannot open '" + path + "'");
+    data.assign(std::istreambuf_iterator<char> {in}, std::istreambuf_iterator<char> {});
+    if (data.size() < headerSize || std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("'" + path + "' is not an input recording");
+    }
+}
+
+bool InputPlayer::Next() {
+    auto take = [this](std::size_t bytes) {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < bytes; ++i) value |= static_cast<std::uint64_t>(data[offset + i]) << (8 * i);
+        offset += bytes;
+        return value;
+    };
+    auto takeDouble = [&] {
+        const std::uint64_t bits = take(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    };
+
+    if (offset + 9 > data.size()) return false;
+    const std::uint8_t mask = data[offset + 8];
+
+    // Check the frame is complete before applying any of it.
+    std::size_t size = 9 + (mask & buttonsChanged ? 1 : 0) + (mask & mouseChanged ? 16 : 0);
+    for (std::size_t word = 0; word < state.keys.size(); ++word) size += mask & (1u << word) ? 8 : 0;
+    if (offset + size > data.size()) return false;
+
+    const double delta = takeDouble();
+    ++offset;
+    for (std::size_t word = 0; word < state.keys.size(); ++word) {
+        if (mask & (1u << word)) state.keys[word] = take(8);
+    }
+    if (mask & buttonsChanged) state.buttons = static_cast<std::uint8_t>(take(1));
+    if (mask & mouseChanged) {
+        state.mouse.x = takeDouble();
+        state.mouse.y = takeDouble();
+    }
+
+    Input::Replay(state);
+    Time::Tick(fixedStep > 0 ? fixedStep : delta);
+    ++frame;
+    return true;
+}
+
+void InputPlayer::Rewind() {
+    offset = headerSize;
+    frame = 0;
+    state = {};
+}
@@ -0,0 +1,86 @@
+#ifndef INPUTRECORDER_H_
+#define INPUTRECORDER_H_
+
+#include "Input.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Writes the Input state and Time::UnscaledDeltaTime of every frame to a file, so a play
+     *        session can be replayed by an InputPlayer, for example as a benchmark.
+     * @details A frame takes a delta time and a byte telling which parts of the state changed,
+     *          followed by only those parts, so frames without input take 9 bytes.
+     */
+    class InputRecorder {
+    public:
+        /**
+         * @brief Constructor, creating the file.
+         * @exception A std::runtime_error is thrown when the file cannot be created.
+         */
+        explicit InputRecorder(const std::string &path);
+
+        /**
+         * @brief Append the current frame. Call once per frame, after Input::Update and Time::Tick.
+         */
+        void Capture();
+
+        /**
+         * @brief The number of frames captured.
+         */
+        [[nodiscard]] std::size_t Frames() const { return frames; }
+
+    private:
+        std::ofstream out;
+        Input::InputState previous {};
+        std::size_t frames {0};
+    };
+
+    /**
+     * @brief Replays a recording made by an InputRecorder in place of live input.
+     * @details Every Next sets the Input state and delta time of one recorded frame, so a main
+     *          loop calling it instead of Input::Update and Time::Tick runs the exact same
+     *          workload each time, as fast as the machine allows; see GameLoop::ExternalClock.
+     */
+    class InputPlayer {
+    public:
+        /**
+         * @brief Constructor, reading the whole recording.
+         * @param path The file written by an InputRecorder.
+         * @param fixedStep The delta time of every frame; 0 uses the recorded delta times.
+         * @exception A std::runtime_error is thrown when the file cannot be read or is not a
+         *            recording.
+         */
+        explicit InputPlayer(const std::string &path, double fixedStep = 0);
+
+        /**
+         * @brief Apply the next frame through Input::Replay and Time::Tick.
+         * @return false when the recording has ended; nothing is changed then.
+         */
+        bool Next();
+
+        /**
+         * @brief Start over at the first frame.
+         */
+        void Rewind();
+
+        /**
+         * @brief The number of frames replayed.
+         */
+        [[nodiscard]] std::size_t Frame() const { return frame; }
+
+    private:
+        std::vector<std::uint8_t> data;
+        std::size_t offset;
+        std::size_t frame {0};
+        double fixedStep;
+        Input::InputState state {};
+    };
+
+}
+
+#endif // INPUTRECORDER_H_
@@ -0,0 +1,219 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <exception>
+
+using namespace spic;
+
+/**
+ * @brief A scheduled job and the bookkeeping of its dependencies.
+ */
+struct JobSystem::Job {
+    std::function<void()> work;
+
+    /**
+     * @brief What work threw, rethrown by Wait.
+     */
+    std::exception_ptr exception;
+
+    /**
+     * @brief Unfinished dependencies, plus one while Schedule is still registering them.
+     */
+    std::atomic<std::size_t> pending {1};
+
+    std::mutex mutex;
+    std::vector<Handle> dependents;
+    bool finished {false};
+    std::atomic<bool> done {false};
+};
+
+namespace {
+
+    /**
+     * @brief The pool the current thread is a worker of, and its queue there.
+     */
+    thread_local const JobSystem *currentSystem {nullptr};
+    thread_local std::size_t currentQueue {0};
+
+}
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    for (unsigned int i = 0; i <= workerCount; ++i) queues.push_back(std::make_unique<Queue>());
+    for (unsigned int i = 0; i < workerCount; ++i) workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock {sleepMutex};
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker: workers) worker.join();
+
+    // Jobs queued from outside after the workers stopped still run, so no Wait hangs.
+    while (RunOne()) {}
+}
+
+JobSystem::Handle JobSystem::Schedule(std::function<void()> work, const std::vector<Handle> &dependencies) {
+    Handle job = std::make_shared<Job>();
+    job->work = std::move(work);
+
+    for (const Handle &dependency: dependencies) {
+        if (dependency == nullptr) continue;
+        std::lock_guard<std::mutex> lock {dependency->mutex};
+        if (!dependency->finished) {
+            job->pending.fetch_add(1, std::memory_order_relaxed);
+            dependency->dependents.push_back(job);
+        }
+    }
+
+    Release(job);
+    return job;
+}
+
+void JobSystem::Wait(const Handle &job) {
+    while (!Finished(job)) {
+        if (!RunOne()) std::this_thread::yield();
+    }
+    if (job != nullptr && job->exception != nullptr) std::rethrow_exception(job->exception);
+}
+
+bool JobSystem::Finished(const Handle &job) {
+    return job == nullptr || job->done.load(std::memory_order_acquire);
+}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t grain,
+                            const std::function<void(std::size_t first, std::size_t last)> &body) {
+    if (count == 0) return;
+
+    // A few ranges per thread, so threads finishing early can take over from slow ones.
+    const std::size_t rangeSize = std::max(std::max<std::size_t>(grain, 1), count / (Threads() * 4));
+    const std::size_t ranges = (count + rangeSize - 1) / rangeSize;
+    if (ranges == 1) {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<std::size_t> next {0};
+    auto work = [&] {
+        try {
+            for (std::size_t range = next++; range < ranges; range = next++) {
+                body(range * rangeSize, std::min(count, (range + 1) * rangeSize));
+            }
+        } catch (...) {
+            next = ranges;
+            throw;
+        }
+    };
+
+    std::vector<Handle> helpers;
+    for (std::size_t i = 1; i < std::min<std::size_t>(Threads(), ranges); ++i) helpers.push_back(Schedule(work));
+
+    // The helpers use this frame, so all of them are waited for before anything is rethrown.
+    std::exception_ptr exception;
+    try {
+        work();
+    } catch (...) {
+        exception = std::current_exception();
+    }
+    for (const Handle &helper: helpers) {
+        try {
+            Wait(helper);
+        } catch (...) {
+            if (exception == nullptr) exception = std::current_exception();
+        }
+    }
+    if (exception != nullptr) std::rethrow_exception(exception);
+}
+
+JobSystem &JobSystem::Shared() {
+    static JobSystem shared;
+    return shared;
+}
+
+unsigned int JobSystem::DefaultWorkers() {
+    return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+}
+
+void JobSystem::Push(Handle job) {
+    const std::size_t index = currentSystem == this ? currentQueue : queues.size() - 1;
+    {
+        // Counted under the queue's lock, so it is never taken before it is counted.
+        std::lock_guard<std::mutex> lock {queues[index]->mutex};
+        queues[index]->jobs.push_back(std::move(job));
+        ready.fetch_add(1, std::memory_order_release);
+    }
+
+    // Taking the lock orders this with a worker that is about to sleep, so it cannot miss the job.
+    { std::lock_guard<std::mutex> lock {sleepMutex}; }
+    wake.notify_one();
+}
+
+JobSystem::Handle JobSystem::Pop() {
+    if (ready.load(std::memory_order_acquire) == 0) return nullptr;
+
+    const bool worker = currentSystem == this;
+    const std::size_t own = worker ? currentQueue : queues.size() - 1;
+
+    // Newest first from the own queue, oldest first from everyone else's.
+    for (std::size_t i = 0; i < queues.size(); ++i) {
+        const std::size_t index = (own + i) % queues.size();
+        Queue &queue = *queues[index];
+        std::lock_guard<std::mutex> lock {queue.mutex};
+        if (queue.jobs.empty()) continue;
+
+        Handle job;
+        if (index == own && worker) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        } else {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+        ready.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+    return nullptr;
+}
+
+bool JobSystem::RunOne() {
+    Handle job = Pop();
+    if (job == nullptr) return false;
+    Run(job);
+    return true;
+}
+
+void JobSystem::Run(const Handle &job) {
+    try {
+        job->work();
+    } catch (...) {
+        job->exception = std::current_exception();
+    }
+    job->work = nullptr;
+
+    std::vector<Handle> dependents;
+    {
+        std::lock_guard<std::mutex> lock {job->mutex};
+        job->finished = true;
+        dependents.swap(job->dependents);
+    }
+    job->done.store(true, std::memory_order_release);
+
+    for (const Handle &dependent: dependents) Release(dependent);
+}
+
+void JobSystem::Release(const Handle &job) {
+    if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) Push(job);
+}
+
+void JobSystem::WorkerLoop(std::size_t index) {
+    currentSystem = this;
+    currentQueue = index;
+
+    while (true) {
+        if (RunOne()) continue;
+
+        std::unique_lock<std::mutex> lock {sleepMutex};
+        wake.wait(lock, [this] { return stopping || ready.load(std::memory_order_acquire) > 0; });
+        if (stopping && ready.load(std::memory_order_acquire) == 0) return;
+    }
+}
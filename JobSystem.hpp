@@ -0,0 +1,134 @@
+#ifndef JOBSYSTEM_H_
+#define JOBSYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief A pool of worker threads running jobs, shared by the engine systems and scripts.
+     * @details Every worker has a queue of its own: jobs it schedules go to the back, and it
+     *          takes its next job from the back as well, which keeps related work on one core.
+     *          A worker with an empty queue steals from the front of the others' queues, so the
+     *          load spreads without a central queue everybody contends on. Jobs scheduled from
+     *          other threads go to a shared queue. A job may depend on other jobs; it is only
+     *          queued once they are finished. Threads waiting for a job run other jobs meanwhile.
+     */
+    class JobSystem {
+    public:
+        struct Job;
+
+        using Handle = std::shared_ptr<Job>;
+
+        /**
+         * @brief Constructor, starting the workers.
+         * @param workers The number of worker threads; the threads calling Wait help as well.
+         */
+        explicit JobSystem(unsigned int workers = DefaultWorkers());
+
+        /**
+         * @brief Destructor, finishing the queued jobs and stopping the workers.
+         */
+        ~JobSystem();
+
+        JobSystem(const JobSystem &other) = delete;
+
+        JobSystem &operator=(const JobSystem &other) = delete;
+
+        /**
+         * @brief Queue a job. May be called from any thread, including from within a job.
+         * @param work What to run.
+         * @param dependencies Jobs that must be finished before this one starts.
+         * @return A handle for Wait, Finished, and as a dependency of later jobs.
+         */
+        Handle Schedule(std::function<void()> work, const std::vector<Handle> &dependencies = {});
+
+        /**
+         * @brief Block until a job is finished, running other jobs in the meantime.
+         * @exception An exception thrown by the job is rethrown.
+         */
+        void Wait(const Handle &job);
+
+        /**
+         * @brief Whether a job is finished.
+         */
+        [[nodiscard]] static bool Finished(const Handle &job);
+
+        /**
+         * @brief Run body over [0, count) in ranges of about grain elements, on all threads,
+         *        and return when all ranges are done.
+         * @param count The number of elements.
+         * @param grain The smallest range worth handing to another thread.
+         * @param body Callable as body(first, last), last exclusive; called concurrently.
+         * @exception The first exception thrown by body is rethrown once every range that was
+         *            started has returned; the ranges not started yet are skipped.
+         */
+        void ParallelFor(std::size_t count, std::size_t grain,
+                         const std::function<void(std::size_t first, std::size_t last)> &body);
+
+        /**
+         * @brief The number of threads that can run jobs at once: the workers plus the caller.
+         */
+        [[nodiscard]] unsigned int Threads() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+        /**
+         * @brief The pool used by the engine, created on first use with DefaultWorkers() workers.
+         */
+        static JobSystem &Shared();
+
+        /**
+         * @brief One worker per hardware thread besides the main thread.
+         */
+        static unsigned int DefaultWorkers();
+
+    private:
+        /**
+         * @brief A queue of jobs that are ready to run.
+         */
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Handle> jobs;
+        };
+
+        void Push(Handle job);
+
+        Handle Pop();
+
+        /**
+         * @brief Run one ready job if there is any.
+         * @return false if no job was ready.
+         */
+        bool RunOne();
+
+        void Run(const Handle &job);
+
+        void Release(const Handle &job);
+
+        void WorkerLoop(std::size_t index);
+
+        /**
+         * @brief One queue per worker, then the shared queue for other threads.
+         */
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+
+        /**
+         * @brief The number of ready jobs in all queues; idle workers sleep while it is 0.
+         */
+        std::atomic<std::size_t> ready {0};
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        bool stopping {false};
+    };
+
+}
+
+#endif // JOBSYSTEM_H_
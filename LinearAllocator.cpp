@@ -0,0 +1,38 @@
+#include "LinearAllocator.hpp"
+#include <algorithm>
+#include <cstdint>
+
+using namespace spic;
+
+LinearAllocator::LinearAllocator(std::size_t blockSize) : blockSize {blockSize} {}
+
+void *LinearAllocator::Allocate(std::size_t size, std::size_t alignment) {
+    while (current < blocks.size()) {
+        Block &block = blocks[current];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+        const std::size_t start = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+        if (start + size <= block.size) {
+            offset = start + size;
+            return block.memory.get() + start;
+        }
+
+        // Does not fit: move on to the next block, which may be left over from before a Reset.
+        ++current;
+        offset = 0;
+    }
+
+    const std::size_t newSize = std::max(blockSize, size + alignment);
+    blocks.push_back({std::make_unique<unsigned char[]>(newSize), newSize});
+    return Allocate(size, alignment);
+}
+
+void LinearAllocator::Reset() {
+    current = 0;
+    offset = 0;
+}
+
+std::size_t LinearAllocator::Capacity() const {
+    std::size_t capacity = 0;
+    for (const Block &block: blocks) capacity += block.size;
+    return capacity;
+}
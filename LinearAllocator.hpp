@@ -0,0 +1,67 @@
+#ifndef LINEARALLOCATOR_H_
+#define LINEARALLOCATOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Hands out memory by bumping an offset, and frees all of it at once with Reset.
+     * @details Meant for per-frame scratch data written by one thread, such as vertices. Memory
+     *          comes from large blocks that are kept across Reset, so once a frame's peak usage
+     *          has been reached it no longer allocates. Destructors are never run, so only
+     *          trivially destructible types can be allocated.
+     */
+    class LinearAllocator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param blockSize The size of the blocks memory is taken from, in bytes. Larger
+         *        allocations get a block of their own.
+         */
+        explicit LinearAllocator(std::size_t blockSize = 1 << 16);
+
+        /**
+         * @brief Allocate uninitialized memory, valid until the next Reset.
+         * @param size The number of bytes.
+         * @param alignment The alignment, a power of two.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Allocate uninitialized memory for count objects of type T.
+         */
+        template<class T>
+        T *Allocate(std::size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value, "LinearAllocator never runs destructors");
+            return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /**
+         * @brief Free everything allocated so far, keeping the blocks for reuse.
+         */
+        void Reset();
+
+        /**
+         * @brief The total size of the blocks held, in bytes.
+         */
+        [[nodiscard]] std::size_t Capacity() const;
+
+    private:
+        struct Block {
+            std::unique_ptr<unsigned char[]> memory;
+            std::size_t size;
+        };
+
+        std::size_t blockSize;
+        std::vector<Block> blocks;
+        std::size_t current {0};
+        std::size_t offset {0};
+    };
+
+}
+
+#endif // LINEARALLOCATOR_H_
@@ -0,0 +1,302 @@
+#include "Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using namespace spic;
+
+namespace {
+
+    std::atomic<std::uint64_t> nextLoggerId {1};
+
+    constexpr std::int64_t nanosecondsPerSecond = 1'000'000'000;
+
+    const char *Name(LogLevel level) {
+        switch (level) {
+            case LogLevel::info:
+                return "info";
+            case LogLevel::warning:
+                return "warning";
+            default:
+                return "error";
+        }
+    }
+
+    /**
+     * @brief FNV-1a over the level and the message.
+     */
+    std::uint64_t Hash(LogLevel level, std::string_view message) {
+        std::uint64_t hash = 14695981039346656037ull ^ static_cast<std::uint64_t>(level);
+        for (const char c: message) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        return hash;
+    }
+
+}
+
+struct Logger::Ring {
+    explicit Ring(std::size_t size) : records {size} {}
+
+    SpscRing<Record> records;
+    const std::thread::id owner {std::this_thread::get_id()};
+
+    /**
+     * @brief Set when the owning thread exits; the ring is removed once it is empty.
+     */
+    std::atomic<bool> closed {false};
+    std::atomic<std::uint64_t> dropped {0};
+    std::atomic<std::uint64_t> suppressed {0};
+
+    /**
+     * @brief How often a message was logged in the current second, by hash; producer only.
+     */
+    struct Repeat {
+        std::uint64_t hash;
+        std::int64_t second;
+        std::uint32_t count;
+        std::uint32_t suppressed;
+    };
+    std::array<Repeat, 64> repeats {};
+
+    /**
+     * @brief The records of the message being written; producer only.
+     */
+    std::vector<Record> scratch;
+};
+
+Logger::Logger(std::size_t ringSize, std::chrono::milliseconds interval)
+        : id {nextLoggerId++}, ringSize {ringSize}, interval {interval}, start {std::chrono::steady_clock::now()},
+          thread {&Logger::Run, this} {}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock {wakeMutex};
+        running = false;
+    }
+    wake.notify_one();
+    thread.join();
+
+    if (file) std::fclose(file);
+}
+
+void Logger::Write(LogLevel level, std::string_view message) {
+    Ring &ring = Local();
+    const std::int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+    std::uint32_t suppressed = 0;
+    const unsigned int limit = perSecond.load(std::memory_order_relaxed);
+    if (limit > 0) {
+        const std::uint64_t hash = Hash(level, message);
+        const std::int64_t second = time / nanosecondsPerSecond;
+        Ring::Repeat &repeat = ring.repeats[hash % ring.repeats.size()];
+        if (repeat.hash != hash) {
+            repeat = {hash, second, 0, 0};
+        } else if (repeat.second != second) {
+            repeat.second = second;
+            repeat.count = 0;
+        }
+
+        if (++repeat.count > limit) {
+            ++repeat.suppressed;
+            ring.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        suppressed = std::exchange(repeat.suppressed, 0);
+    }
+
+    // All records of a message are pushed at once, or the message is dropped.
+    const std::size_t count = std::max<std::size_t>((message.size() + recordText - 1) / recordText, 1);
+    if (ring.records.Capacity() - ring.records.Size() < count) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring.scratch.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Record &record = ring.scratch[i];
+        const std::string_view part = message.substr(i * recordText, recordText);
+        record.time = time;
+        record.suppressed = suppressed;
+        record.length = static_cast<std::uint16_t>(part.size());
+        record.level = level;
+        record.more = i + 1 < count;
+        std::copy(part.begin(), part.end(), record.text);
+    }
+    ring.records.Push(ring.scratch.data(), count);
+
+    if (level == LogLevel::error) {
+        urgent.store(true, std::memory_order_release);
+        wake.notify_one();
+    }
+}
+
+void Logger::Flush() {
+    std::unique_lock<std::mutex> lock {wakeMutex};
+    const std::uint64_t ticket = ++flushRequested;
+    wake.notify_one();
+    flushed.wait(lock, [this, ticket] { return flushDone >= ticket; });
+}
+
+void Logger::Console(bool enabled) {
+    std::lock_guard<std::mutex> lock {sinkMutex};
+    console = enabled;
+}
+
+void Logger::File(const std::string &path) {
+    std::FILE *opened = nullptr;
+    if (!path.empty()) {
+        opened = std::fopen(path.c_str(), "w");
+        if (!opened) throw std::runtime_error("Cannot open log file " + path);
+    }
+
+    std::lock_guard<std::mutex> lock {sinkMutex};
+    if (file) std::fclose(file);
+    file = opened;
+}
+
+void Logger::RateLimit(unsigned int newPerSecond) {
+    perSecond.store(newPerSecond, std::memory_order_relaxed);
+}
+
+std::uint64_t Logger::Dropped() const {
+    std::lock_guard<std::mutex> lock {ringsMutex};
+    std::uint64_t dropped = retiredDropped;
+    for (const auto &ring: rings) dropped += ring->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+std::uint64_t Logger::Suppressed() const {
+    std::lock_guard<std::mutex> lock {ringsMutex};
+    std::uint64_t suppressed = retiredSuppressed;
+    for (const auto &ring: rings) suppressed += ring->suppressed.load(std::memory_order_relaxed);
+    return suppressed;
+}
+
+Logger &Logger::Shared() {
+    static Logger shared;
+    return shared;
+}
+
+Logger::Ring &Logger::Local() {
+    // Remembers the ring of the logger this thread used last, and closes it when the thread exits.
+    struct Cache {
+        std::uint64_t logger {0};
+        std::shared_ptr<Ring> ring;
+
+        ~Cache() {
+            if (ring) ring->closed.store(true, std::memory_order_release);
+        }
+    };
+    thread_local Cache cache;
+    if (cache.logger == id) return *cache.ring;
+
+    std::lock_guard<std::mutex> lock {ringsMutex};
+    auto found = std::find_if(rings.begin(), rings.end(), [](const std::shared_ptr<Ring> &ring) {
+        return ring->owner == std::this_thread::get_id() && !ring->closed.load(std::memory_order_relaxed);
+    });
+    if (found == rings.end()) found = rings.insert(rings.end(), std::make_shared<Ring>(ringSize));
+
+    cache.logger = id;
+    cache.ring = *found;
+    return *cache.ring;
+}
+
+void Logger::Run() {
+    std::unique_lock<std::mutex> lock {wakeMutex};
+    while (true) {
+        wake.wait_for(lock, interval, [this] {
+            return !running || flushRequested != flushDone || urgent.load(std::memory_order_acquire);
+        });
+        const bool stopping = !running;
+        const std::uint64_t requested = flushRequested;
+        lock.unlock();
+
+        urgent.store(false, std::memory_order_relaxed);
+        Drain();
+
+        lock.lock();
+        flushDone = requested;
+        flushed.notify_all();
+        if (stopping) return;
+    }
+}
+
+void Logger::Drain() {
+    records.clear();
+    std::uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock {ringsMutex};
+        for (auto ring = rings.begin(); ring != rings.end();) {
+            // Checked before emptying, so a closed ring is only removed once nothing can follow.
+            const bool closed = (*ring)->closed.load(std::memory_order_acquire);
+            const std::size_t offset = records.size();
+            records.resize(offset + (*ring)->records.Size());
+            records.resize(offset + (*ring)->records.Pop(records.data() + offset, records.size() - offset));
+            dropped += (*ring)->dropped.load(std::memory_order_relaxed);
+
+            if (closed && (*ring)->records.Size() == 0) {
+                retiredDropped += (*ring)->dropped.load(std::memory_order_relaxed);
+                retiredSuppressed += (*ring)->suppressed.load(std::memory_order_relaxed);
+                dropped -= (*ring)->dropped.load(std::memory_order_relaxed);
+                ring = rings.erase(ring);
+            } else {
+                ++ring;
+            }
+        }
+        dropped += retiredDropped;
+    }
+
+    // Rings are emptied one after another; order the messages of all threads by time.
+    order.clear();
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const bool head = i == 0 || !records[i - 1].more;
+        if (head) order.emplace_back(records[i].time, i);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    out.clear();
+    errors.clear();
+    all.clear();
+    for (const auto &[time, first]: order) {
+        message.clear();
+        std::size_t i = first;
+        do {
+            message.append(records[i].text, records[i].length);
+        } while (records[i++].more);
+        Emit(time, records[first].level, message, records[first].suppressed);
+    }
+
+    if (dropped > reportedDropped) {
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        Emit(now, LogLevel::warning, std::to_string(dropped - reportedDropped) + " log messages dropped", 0);
+        reportedDropped = dropped;
+    }
+    if (all.empty()) return;
+
+    std::lock_guard<std::mutex> lock {sinkMutex};
+    if (console) {
+        std::fwrite(out.data(), 1, out.size(), stdout);
+        std::fflush(stdout);
+        std::fwrite(errors.data(), 1, errors.size(), stderr);
+        std::fflush(stderr);
+    }
+    if (file) {
+        std::fwrite(all.data(), 1, all.size(), file);
+        std::fflush(file);
+    }
+}
+
+void Logger::Emit(std::int64_t time, LogLevel level, std::string_view text, std::uint32_t suppressed) {
+    char prefix[48];
+    std::snprintf(prefix, sizeof(prefix), "[%.6f] [%s] ", static_cast<double>(time) / nanosecondsPerSecond,
+                  Name(level));
+
+    line.assign(prefix);
+    line.append(text);
+    if (suppressed > 0) line.append(" (" + std::to_string(suppressed) + " repeats suppressed)");
+    line.push_back('\n');
+
+    (level == LogLevel::error ? errors : out).append(line);
+    all.append(line);
+}
@@ -0,0 +1,205 @@
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+#include "SpscRing.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The least severe LogLevel that is logged: 0 info, 1 warning, 2 error, 3 nothing.
+ * @details Define it before including this header, or on the command line, to remove the
+ *          SPIC_LOG, SPIC_LOG_WARNING and SPIC_LOG_ERROR calls below it from the build entirely;
+ *          their arguments are not evaluated then. Debug::Log, LogWarning and LogError follow
+ *          the level the engine was built with.
+ */
+#ifndef SPIC_LOG_LEVEL
+#define SPIC_LOG_LEVEL 0
+#endif
+
+#if SPIC_LOG_LEVEL <= 0
+#define SPIC_LOG(message) ::spic::Logger::Shared().Write(::spic::LogLevel::info, (message))
+#else
+#define SPIC_LOG(message) ((void) 0)
+#endif
+
+#if SPIC_LOG_LEVEL <= 1
+#define SPIC_LOG_WARNING(message) ::spic::Logger::Shared().Write(::spic::LogLevel::warning, (message))
+#else
+#define SPIC_LOG_WARNING(message) ((void) 0)
+#endif
+
+#if SPIC_LOG_LEVEL <= 2
+#define SPIC_LOG_ERROR(message) ::spic::Logger::Shared().Write(::spic::LogLevel::error, (message))
+#else
+#define SPIC_LOG_ERROR(message) ((void) 0)
+#endif
+
+namespace spic {
+
+    /**
+     * @brief How severe a log message is; see SPIC_LOG_LEVEL.
+     */
+    enum class LogLevel : std::uint8_t {
+        info = 0,
+        warning = 1,
+        error = 2
+    };
+
+    /**
+     * @brief Writes log messages on a background thread, so logging never waits for the console
+     *        or a file.
+     * @details Each thread that logs gets a lock-free ring of its own, into which Write copies the
+     *          message; the background thread empties the rings every few milliseconds, orders
+     *          the messages by time, and writes them in one go. When a thread's ring is full its
+     *          messages are dropped and counted. A thread repeating one message more often than
+     *          the rate limit has the repeats suppressed and counted; the next copy that gets
+     *          through says how many were left out.
+     */
+    class Logger {
+    public:
+        /**
+         * @brief Constructor, starting the background thread. Messages go to the console.
+         * @param ringSize The number of records in each thread's ring; a record holds up to
+         *        recordText characters, longer messages take several.
+         * @param interval How long the background thread sleeps between writes.
+         */
+        explicit Logger(std::size_t ringSize = 1024,
+                        std::chrono::milliseconds interval = std::chrono::milliseconds {5});
+
+        /**
+         * @brief Writes the messages still queued and stops the background thread.
+         */
+        ~Logger();
+
+        Logger(const Logger &other) = delete;
+
+        Logger &operator=(const Logger &other) = delete;
+
+        /**
+         * @brief Queue a message; safe to call from any thread, and never blocks except on the
+         *        first call from a thread.
+         * @details Errors wake the background thread, so they are written right away. Prefer the
+         *          SPIC_LOG macros, which compile to nothing below SPIC_LOG_LEVEL.
+         */
+        void Write(LogLevel level, std::string_view message);
+
+        /**
+         * @brief Wait until every message queued before the call has been written.
+         */
+        void Flush();
+
+        /**
+         * @brief Turn writing to the console on or off; errors go to stderr, the rest to stdout.
+         */
+        void Console(bool enabled);
+
+        /**
+         * @brief Also write to a file, which is truncated first; an empty path stops writing to file.
+         * @exception A std::runtime_error is thrown when the file cannot be opened.
+         */
+        void File(const std::string &path);
+
+        /**
+         * @brief The number of copies of one message a thread may log per second before the rest
+         *        are suppressed; 0 turns rate limiting off.
+         */
+        void RateLimit(unsigned int perSecond);
+
+        /**
+         * @brief The number of messages dropped because a ring was full.
+         */
+        [[nodiscard]] std::uint64_t Dropped() const;
+
+        /**
+         * @brief The number of messages suppressed by the rate limit.
+         */
+        [[nodiscard]] std::uint64_t Suppressed() const;
+
+        /**
+         * @brief The logger behind Debug::Log, Debug::LogWarning and Debug::LogError.
+         */
+        static Logger &Shared();
+
+        /**
+         * @brief The number of characters of a message one ring record holds.
+         */
+        static constexpr std::size_t recordText = 240;
+
+    private:
+        struct Record {
+            std::int64_t time;
+            std::uint32_t suppressed;
+            std::uint16_t length;
+            LogLevel level;
+
+            /**
+             * @brief The message continues in the next record.
+             */
+            bool more;
+            char text[recordText];
+        };
+
+        struct Ring;
+
+        Ring &Local();
+
+        void Run();
+
+        void Drain();
+
+        void Emit(std::int64_t time, LogLevel level, std::string_view text, std::uint32_t suppressed);
+
+        const std::uint64_t id;
+        const std::size_t ringSize;
+        const std::chrono::milliseconds interval;
+        const std::chrono::steady_clock::time_point start;
+        std::atomic<unsigned int> perSecond {20};
+        std::atomic<bool> urgent {false};
+
+        mutable std::mutex ringsMutex;
+        std::vector<std::shared_ptr<Ring>> rings;
+        std::uint64_t retiredDropped {0};
+        std::uint64_t retiredSuppressed {0};
+
+        std::mutex sinkMutex;
+        bool console {true};
+        std::FILE *file {nullptr};
+
+        /**
+         * @brief Wakes the background thread, and tells Flush callers how far it got.
+         */
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::condition_variable flushed;
+        std::uint64_t flushRequested {0};
+        std::uint64_t flushDone {0};
+        bool running {true};
+
+        /**
+         * @brief Used by the background thread only.
+         */
+        std::vector<Record> records;
+        std::vector<std::pair<std::int64_t, std::size_t>> order;
+        std::string message;
+        std::string line;
+        std::string out;
+        std::string errors;
+        std::string all;
+        std::uint64_t reportedDropped {0};
+
+        std::thread thread;
+    };
+
+}
+
+#endif // LOGGER_H_
@@ -0,0 +1,80 @@
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace spic;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path) {
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open '" + path + "'");
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+    if (size == 0) return;
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr) data = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr) {
+        if (mapping != nullptr) CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map '" + path + "'");
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) UnmapViewOfFile(data);
+    if (mapping != nullptr) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+}
+
+void MappedFile::Prefetch(std::size_t, std::size_t) const {}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) {
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) throw std::runtime_error("Cannot open '" + path + "'");
+
+    struct stat status {};
+    fstat(descriptor, &status);
+    size = static_cast<std::size_t>(status.st_size);
+
+    if (size > 0) {
+        void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address == MAP_FAILED) {
+            close(descriptor);
+            throw std::runtime_error("Cannot map '" + path + "'");
+        }
+        data = static_cast<const unsigned char *>(address);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    close(descriptor);
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) munmap(const_cast<unsigned char *>(data), size);
+}
+
+void MappedFile::Prefetch(std::size_t offset, std::size_t length) const {
+    if (data == nullptr || offset >= size) return;
+
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t start = offset / page * page;
+    madvise(const_cast<unsigned char *>(data) + start, std::min(size, offset + length) - start, MADV_WILLNEED);
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace spic {
+
+    /**
+     * @brief A file mapped read-only into memory. Pages are read from disk on first access, so
+     *        opening a large file is cheap and only the parts actually used take up memory.
+     */
+    class MappedFile {
+    public:
+        /**
+         * @brief Constructor, mapping the whole file.
+         * @exception A std::runtime_error is thrown when the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::string &path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile &other) = delete;
+
+        MappedFile &operator=(const MappedFile &other) = delete;
+
+        [[nodiscard]] const unsigned char *Data() const { return data; }
+
+        [[nodiscard]] std::size_t Size() const { return size; }
+
+        /**
+         * @brief Ask the system to start reading part of the file, so later accesses do not wait.
+         */
+        void Prefetch(std::size_t offset, std::size_t length) const;
+
+    private:
+        const unsigned char *data {nullptr};
+        std::size_t size {0};
+#ifdef _WIN32
+        void *file {nullptr};
+        void *mapping {nullptr};
+#endif
+    };
+
+}
+
+#endif // MAPPEDFILE_H_
@@ -0,0 +1,414 @@
+#include "Physics.hpp"
+#include "BoxCollider.hpp"
+#include "CircleCollider.hpp"
+#include "JobSystem.hpp"
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+using namespace spic;
+
+namespace {
+
+    enum class Shape {
+        box,
+        circle
+    };
+
+    /**
+     * @brief The world-space shape of a registered collider, as seen by the queries.
+     */
+    struct Proxy {
+        Collider *collider;
+        Shape shape;
+        Point center;
+        Point halfExtents;
+        double radius;
+        unsigned int layerBit;
+    };
+
+    /**
+     * @brief Batches smaller than this are not worth spreading over threads.
+     */
+    constexpr std::size_t minRaysPerThread = 256;
+
+    SpatialGrid grid {4.0};
+    std::vector<Proxy> proxies;
+    std::unordered_map<const Collider *, int> proxyIds;
+
+    void ReadShape(Proxy &proxy) {
+        if (proxy.shape == Shape::circle) {
+            proxy.radius = static_cast<const CircleCollider *>(proxy.collider)->Radius();
+            proxy.halfExtents = {proxy.radius, proxy.radius};
+        } else {
+            const auto *box = static_cast<const BoxCollider *>(proxy.collider);
+            proxy.halfExtents = {box->Width() / 2, box->Height() / 2};
+            proxy.radius = 0;
+        }
+    }
+
+    Rect BoundsOf(const Proxy &proxy) {
+        return {proxy.center.x - proxy.halfExtents.x, proxy.center.y - proxy.halfExtents.y,
+                2 * proxy.halfExtents.x, 2 * proxy.halfExtents.y};
+    }
+
+    double Dot(const Point &a, const Point &b) {
+        return a.x * b.x + a.y * b.y;
+    }
+
+    /**
+     * @brief Intersect a ray with an axis-aligned box centered on the origin.
+     * @param start The start of the ray, relative to the box center.
+     * @param motion The direction of the ray; the result is in multiples of it.
+     * @return The ray parameter of the hit, 0 if start is inside, or a negative value on a miss.
+     */
+    double RayBox(const Point &start, const Point &motion, const Point &half, Point &normal) {
+        double enter = 0;
+        double exit = std::numeric_limits<double>::infinity();
+        Point enterNormal {-motion.x, -motion.y};
+
+        const double starts[2] = {start.x, start.y};
+        const double motions[2] = {motion.x, motion.y};
+        const double extents[2] = {half.x, half.y};
+
+        for (int axis = 0; axis < 2; ++axis) {
+            if (motions[axis] == 0) {
+                if (std::abs(starts[axis]) > extents[axis]) return -1;
+                continue;
+            }
+
+            const double inverse = 1 / motions[axis];
+            double near = (-extents[axis] - starts[axis]) * inverse;
+            double far = (extents[axis] - starts[axis]) * inverse;
+            if (near > far) std::swap(near, far);
+
+            if (near > enter) {
+                enter = near;
+                const double side = motions[axis] > 0 ? -1.0 : 1.0;
+                enterNormal = axis == 0 ? Point {side, 0} : Point {0, side};
+            }
+            exit = std::min(exit, far);
+            if (enter > exit) return -1;
+        }
+
+        normal = enterNormal;
+        return enter;
+    }
+
+    /**
+     * @brief Intersect a ray with a circle.
+     * @param start The start of the ray, relative to the circle center.
+     * @param motion The direction of the ray; the result is in multiples of it.
+     * @return The ray parameter of the hit, 0 if start is inside, or a negative value on a miss.
+     */
+    double RayCircle(const Point &start, const Point &motion, double radius, Point &normal) {
+        const double a = Dot(motion, motion);
+        const double b = Dot(start, motion);
+        const double c = Dot(start, start) - radius * radius;
+        if (c <= 0) {
+            normal = {-motion.x, -motion.y};
+            return 0;
+        }
+        if (b > 0 || a == 0) return -1;
+
+        const double discriminant = b * b - a * c;
+        if (discriminant < 0) return -1;
+
+        const double t = (-b - std::sqrt(discriminant)) / a;
+        normal = {(start.x + t * motion.x) / radius, (start.y + t * motion.y) / radius};
+        return t;
+    }
+
+    /**
+     * @brief Intersect a ray with a box whose corners are rounded off by a radius: the
+     *        Minkowski sum of a box and a circle.
+     * @details Every pairing of a moving point, circle or box against a static circle or box
+     *          reduces to this shape, which is how the casts get their time of impact.
+     * @param start The start of the ray, relative to the box center.
+     * @param motion The direction of the ray; the result is in multiples of it.
+     * @param half The half extents of the box before rounding.
+     * @param round The rounding radius.
+     * @return The ray parameter of the hit, 0 if start is inside, or a negative value on a miss.
+     */
+    double RayRoundedBox(const Point &start, const Point &motion, const Point &half, double round,
+                         Point &normal) {
+        if (round == 0) return RayBox(start, motion, half, normal);
+        if (half.x == 0 && half.y == 0) return RayCircle(start, motion, round, normal);
+
+        double best = -1;
+        Point candidateNormal {};
+        auto consider = [&](double t) {
+            if (t >= 0 && (best < 0 || t < best)) {
+                best = t;
+                normal = candidateNormal;
+            }
+        };
+
+        // The rounded box is the union of two crossed boxes and a circle on every corner.
+        consider(RayBox(start, motion, {half.x + round, half.y}, candidateNormal));
+        consider(RayBox(start, motion, {half.x, half.y + round}, candidateNormal));
+        for (double cornerX: {-half.x, half.x}) {
+            for (double cornerY: {-half.y, half.y}) {
+                consider(RayCircle({start.x - cornerX, start.y - cornerY}, motion, round, candidateNormal));
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * @brief The box part of a proxy, without the rounding of a circle.
+     */
+    Point CoreOf(const Proxy &proxy) {
+        return proxy.shape == Shape::circle ? Point {0, 0} : proxy.halfExtents;
+    }
+
+    /**
+     * @brief Sweep a shape along motion against a proxy.
+     * @param start The center of the moving shape.
+     * @param motion The displacement of the moving shape.
+     * @param half The half extents of the moving shape if it is a box, otherwise zero.
+     * @param radius The radius of the moving shape if it is a circle, otherwise zero.
+     * @return The fraction of motion at the time of impact, or a negative value on a miss.
+     */
+    double Sweep(const Proxy &proxy, const Point &start, const Point &motion, const Point &half, double radius,
+                 Point &normal) {
+        const Point core = CoreOf(proxy);
+        return RayRoundedBox({start.x - proxy.center.x, start.y - proxy.center.y}, motion,
+                             {core.x + half.x, core.y + half.y}, proxy.radius + radius, normal);
+    }
+
+    /**
+     * @brief The distance from a point to the surface of a proxy, 0 if the point is inside.
+     */
+    double DistanceTo(const Proxy &proxy, const Point &point) {
+        const Point core = CoreOf(proxy);
+        const double dx = std::max(0.0, std::abs(point.x - proxy.center.x) - core.x);
+        const double dy = std::max(0.0, std::abs(point.y - proxy.center.y) - core.y);
+        return std::max(0.0, std::sqrt(dx * dx + dy * dy) - proxy.radius);
+    }
+
+    /**
+     * @brief Insert a hit into a buffer sorted by distance, dropping the furthest one when full.
+     */
+    void InsertSorted(const RaycastHit &hit, RaycastHit *hits, std::size_t &count, std::size_t capacity) {
+        if (count == capacity && hits[count - 1].distance <= hit.distance) return;
+
+        std::size_t index = count < capacity ? count++ : count - 1;
+        while (index > 0 && hits[index - 1].distance > hit.distance) {
+            hits[index] = hits[index - 1];
+            --index;
+        }
+        hits[index] = hit;
+    }
+
+    /**
+     * @brief Sweep a circle (radius > 0) or box (half > 0) and find the first collider it touches.
+     */
+    bool Cast(const Point &center, const Point &half, double radius, const Point &direction, double maxDistance,
+              unsigned int layerMask, RaycastHit &hit, const Collider *ignore) {
+        hit = {nullptr, center, {0, 0}, 0};
+
+        const double length = std::sqrt(Dot(direction, direction));
+        if (length == 0) return false;
+
+        const Point motion {direction.x / length * maxDistance, direction.y / length * maxDistance};
+        const Point reach {half.x + radius, half.y + radius};
+        const Rect swept {std::min(center.x, center.x + motion.x) - reach.x,
+                          std::min(center.y, center.y + motion.y) - reach.y,
+                          std::abs(motion.x) + 2 * reach.x, std::abs(motion.y) + 2 * reach.y};
+        double best = 2;
+
+        grid.Query(swept, [&](int id) {
+            const Proxy &proxy = proxies[id];
+            if (proxy.collider == ignore || (proxy.layerBit & layerMask) == 0) return;
+
+            Point normal {};
+            const double fraction = Sweep(proxy, center, motion, half, radius, normal);
+            if (fraction < 0 || fraction > 1 || fraction >= best) return;
+
+            best = fraction;
+            const double normalLength = std::sqrt(Dot(normal, normal));
+            hit = {proxy.collider, {center.x + fraction * motion.x, center.y + fraction * motion.y},
+                   {normal.x / normalLength, normal.y / normalLength}, fraction * maxDistance};
+        });
+
+        return hit.collider != nullptr;
+    }
+
+    void CastRays(const RaycastCommand *commands, std::size_t count, RaycastHit *results) {
+        for (std::size_t i = 0; i < count; ++i) {
+            Physics::Raycast(commands[i].origin, commands[i].direction, commands[i].maxDistance,
+                             commands[i].layerMask, results[i]);
+        }
+    }
+
+}
+
+void Physics::AddCollider(Collider &collider, int layer, const Point &position) {
+    Proxy proxy {&collider, dynamic_cast<CircleCollider *>(&collider) ? Shape::circle : Shape::box, position,
+                 {0, 0}, 0, 1u << layer};
+    ReadShape(proxy);
+
+    const int id = grid.Insert(BoundsOf(proxy));
+    if (static_cast<std::size_t>(id) >= proxies.size()) proxies.resize(id + 1);
+    proxies[id] = proxy;
+    proxyIds[&collider] = id;
+}
+
+void Physics::MoveCollider(const Collider &collider, const Point &position) {
+    auto found = proxyIds.find(&collider);
+    if (found == proxyIds.end()) return;
+
+    Proxy &proxy = proxies[found->second];
+    proxy.center = position;
+    ReadShape(proxy);
+    grid.Update(found->second, BoundsOf(proxy));
+}
+
+void Physics::RemoveCollider(const Collider &collider) {
+    auto found = proxyIds.find(&collider);
+    if (found == proxyIds.end()) return;
+
+    grid.Remove(found->second);
+    proxyIds.erase(found);
+}
+
+void Physics::CellSize(double cellSize) {
+    SpatialGrid rebuilt {cellSize};
+    std::vector<Proxy> moved;
+
+    for (auto &entry: proxyIds) {
+        const Proxy proxy = proxies[entry.second];
+        entry.second = rebuilt.Insert(BoundsOf(proxy));
+        if (static_cast<std::size_t>(entry.second) >= moved.size()) moved.resize(entry.second + 1);
+        moved[entry.second] = proxy;
+    }
+
+    grid = std::move(rebuilt);
+    proxies = std::move(moved);
+}
+
+std::size_t Physics::Raycast(const Point &origin, const Point &direction, double maxDistance,
+                             unsigned int layerMask, RaycastHit *hits, std::size_t capacity) {
+    const double length = std::sqrt(Dot(direction, direction));
+    if (capacity == 0 || length == 0) return 0;
+
+    const Point unit {direction.x / length, direction.y / length};
+    std::size_t count = 0;
+
+    grid.Traverse(origin, unit, maxDistance, [&](const std::vector<int> &ids, double enter, double exit) {
+        for (int id: ids) {
+            const Proxy &proxy = proxies[id];
+            if ((proxy.layerBit & layerMask) == 0) continue;
+
+            Point normal {};
+            const double t = Sweep(proxy, origin, unit, {0, 0}, 0, normal);
+            // Only accept hits inside this cell; the others are reported by the cell they lie in.
+            if (t < 0 || t > maxDistance || t < enter || t >= exit) continue;
+
+            InsertSorted({proxy.collider, {origin.x + t * unit.x, origin.y + t * unit.y}, normal, t},
+                         hits, count, capacity);
+        }
+
+        return count < capacity || hits[capacity - 1].distance >= exit;
+    });
+
+    return count;
+}
+
+bool Physics::Raycast(const Point &origin, const Point &direction, double maxDistance,
+                      unsigned int layerMask, RaycastHit &hit) {
+    if (Raycast(origin, direction, maxDistance, layerMask, &hit, 1) == 1) return true;
+
+    hit = {nullptr, {0, 0}, {0, 0}, 0};
+    return false;
+}
+
+void Physics::RaycastBatch(const RaycastCommand *commands, std::size_t count, RaycastHit *results) {
+    JobSystem::Shared().ParallelFor(count, minRaysPerThread, [commands, results](std::size_t first, std::size_t last) {
+        CastRays(commands + first, last - first, results + first);
+    });
+}
+
+bool Physics::CircleCast(const Point &center, double radius, const Point &direction, double maxDistance,
+                         unsigned int layerMask, RaycastHit &hit, const Collider *ignore) {
+    return Cast(center, {0, 0}, radius, direction, maxDistance, layerMask, hit, ignore);
+}
+
+bool Physics::BoxCast(const Point &center, const Point &size, const Point &direction, double maxDistance,
+                      unsigned int layerMask, RaycastHit &hit, const Collider *ignore) {
+    return Cast(center, {size.x / 2, size.y / 2}, 0, direction, maxDistance, layerMask, hit, ignore);
+}
+
+std::size_t Physics::OverlapCircle(const Point &center, double radius, unsigned int layerMask,
+                                   Collider **results, std::size_t capacity) {
+    std::size_t count = 0;
+
+    grid.Query({center.x - radius, center.y - radius, 2 * radius, 2 * radius}, [&](int id) {
+        const Proxy &proxy = proxies[id];
+        if (count < capacity && (proxy.layerBit & layerMask) != 0 && DistanceTo(proxy, center) <= radius) {
+            results[count++] = proxy.collider;
+        }
+    });
+
+    return count;
+}
+
+std::size_t Physics::OverlapBox(const Point &center, const Point &size, unsigned int layerMask,
+                                Collider **results, std::size_t capacity) {
+    const Rect area {center.x - size.x / 2, center.y - size.y / 2, size.x, size.y};
+    std::size_t count = 0;
+
+    grid.Query(area, [&](int id) {
+        const Proxy &proxy = proxies[id];
+        if (count == capacity || (proxy.layerBit & layerMask) == 0) return;
+
+        if (proxy.shape == Shape::circle) {
+            // The grid only checked the circle's bounding box; check the circle itself.
+            const Point closest {std::min(std::max(proxy.center.x, area.x), area.x + area.width),
+                                 std::min(std::max(proxy.center.y, area.y), area.y + area.height)};
+            const double dx = closest.x - proxy.center.x;
+            const double dy = closest.y - proxy.center.y;
+            if (dx * dx + dy * dy > proxy.radius * proxy.radius) return;
+        }
+
+        results[count++] = proxy.collider;
+    });
+
+    return count;
+}
+
+std::size_t Physics::Nearest(const Point &point, std::size_t k, double maxDistance, unsigned int layerMask,
+                             Collider **results) {
+    if (k == 0) return 0;
+
+    // Scratch space for the distances belonging to results; grows once per thread and is then reused.
+    thread_local std::vector<double> distances;
+    if (distances.size() < k) distances.resize(k);
+
+    std::size_t count = 0;
+
+    grid.VisitRings(point, [&](int id) {
+        const Proxy &proxy = proxies[id];
+        if ((proxy.layerBit & layerMask) == 0) return;
+
+        const double distance = DistanceTo(proxy, point);
+        if (distance > maxDistance || (count == k && distances[k - 1] <= distance)) return;
+
+        std::size_t index = count < k ? count++ : k - 1;
+        while (index > 0 && distances[index - 1] > distance) {
+            distances[index] = distances[index - 1];
+            results[index] = results[index - 1];
+            --index;
+        }
+        distances[index] = distance;
+        results[index] = proxy.collider;
+    }, [&](double lowerBound) {
+        return lowerBound <= maxDistance && (count < k || lowerBound < distances[k - 1]);
+    });
+
+    return count;
+}
@@ -0,0 +1,190 @@
+#ifndef PHYSICS_H_
+#define PHYSICS_H_
+
+#include "Collider.hpp"
+#include "Point.hpp"
+#include <cstddef>
+#include <limits>
+
+namespace spic {
+
+    /**
+     * @brief Information about a collider hit by a ray.
+     */
+    struct RaycastHit {
+        /**
+         * @brief The collider that was hit, or nullptr if nothing was hit.
+         */
+        Collider *collider;
+
+        /**
+         * @brief The world-space point where the ray entered the collider.
+         */
+        Point point;
+
+        /**
+         * @brief The surface normal at the hit point.
+         */
+        Point normal;
+
+        /**
+         * @brief The distance from the ray origin to the hit point.
+         */
+        double distance;
+    };
+
+    /**
+     * @brief The arguments of one raycast, for use with Physics::RaycastBatch.
+     */
+    struct RaycastCommand {
+        Point origin;
+        Point direction;
+        double maxDistance;
+        unsigned int layerMask;
+    };
+
+    /**
+     * @brief Spatial queries against all colliders in the scene.
+     * @details The queries run on a spatial grid over the colliders' bounds instead of looping
+     *          over every GameObject, and write their results into buffers supplied by the
+     *          caller so that they never allocate. Queries may run concurrently from several
+     *          threads, but not while colliders are being added, moved or removed.
+     */
+    namespace Physics {
+
+        /**
+         * @brief Layer mask matching every layer. Bit n of a layer mask selects GameObject layer n.
+         */
+        constexpr unsigned int AllLayers = ~0u;
+
+        /**
+         * @brief Make a BoxCollider or CircleCollider known to the spatial queries.
+         * @param collider The collider, which must outlive its registration.
+         * @param layer The layer of the GameObject owning the collider, 0 ≤ layer < 32.
+         * @param position The world-space center of the collider.
+         */
+        void AddCollider(Collider &collider, int layer, const Point &position);
+
+        /**
+         * @brief Update a registered collider after it moved or changed size.
+         * @param collider The collider.
+         * @param position The new world-space center of the collider.
+         */
+        void MoveCollider(const Collider &collider, const Point &position);
+
+        /**
+         * @brief Forget a registered collider.
+         * @param collider The collider.
+         */
+        void RemoveCollider(const Collider &collider);
+
+        /**
+         * @brief Set the cell size of the spatial grid used by the queries.
+         * @details About twice the size of a typical collider works well. Changing it rebuilds
+         *          the grid.
+         * @param cellSize The width and height of one grid cell in world units.
+         */
+        void CellSize(double cellSize);
+
+        /**
+         * @brief Cast a ray and report the colliders it hits, nearest first.
+         * @param origin The start of the ray.
+         * @param direction The direction of the ray; does not have to be normalized.
+         * @param maxDistance How far the ray reaches.
+         * @param layerMask Only colliders on these layers are considered.
+         * @param hits Buffer receiving the hits.
+         * @param capacity The number of elements in hits; at most this many nearest hits are reported.
+         * @return The number of hits written.
+         */
+        std::size_t Raycast(const Point &origin, const Point &direction, double maxDistance,
+                            unsigned int layerMask, RaycastHit *hits, std::size_t capacity);
+
+        /**
+         * @brief Cast a ray and report the nearest collider it hits.
+         * @param hit Receives the hit; hit.collider is nullptr if nothing was hit.
+         * @return true if something was hit.
+         */
+        bool Raycast(const Point &origin, const Point &direction, double maxDistance,
+                     unsigned int layerMask, RaycastHit &hit);
+
+        /**
+         * @brief Cast many rays at once, for example for line-of-sight checks, spreading the work
+         *        over the shared JobSystem when the batch is large.
+         * @param commands The rays to cast.
+         * @param count The number of commands.
+         * @param results Buffer of count elements receiving the nearest hit of each ray.
+         */
+        void RaycastBatch(const RaycastCommand *commands, std::size_t count, RaycastHit *results);
+
+        /**
+         * @brief Sweep a circle along a direction and report the first collider it touches.
+         * @details The time of impact is solved exactly rather than by stepping, so a small, fast
+         *          shape cannot tunnel through thin colliders. This is how continuous collision
+         *          detection moves RigidBody bullets.
+         * @param center The center of the circle at the start of the sweep.
+         * @param radius The radius of the circle.
+         * @param direction The direction of the sweep; does not have to be normalized.
+         * @param maxDistance How far the circle travels.
+         * @param layerMask Only colliders on these layers are considered.
+         * @param hit Receives the hit; hit.point is the center of the circle at the time of impact.
+         * @param ignore A collider to skip, usually the one of the moving body itself.
+         * @return true if something was hit.
+         */
+        bool CircleCast(const Point &center, double radius, const Point &direction, double maxDistance,
+                        unsigned int layerMask, RaycastHit &hit, const Collider *ignore = nullptr);
+
+        /**
+         * @brief Sweep an axis-aligned box along a direction and report the first collider it touches.
+         * @param center The center of the box at the start of the sweep.
+         * @param size The width (x) and height (y) of the box.
+         * @param direction The direction of the sweep; does not have to be normalized.
+         * @param maxDistance How far the box travels.
+         * @param layerMask Only colliders on these layers are considered.
+         * @param hit Receives the hit; hit.point is the center of the box at the time of impact.
+         * @param ignore A collider to skip, usually the one of the moving body itself.
+         * @return true if something was hit.
+         */
+        bool BoxCast(const Point &center, const Point &size, const Point &direction, double maxDistance,
+                     unsigned int layerMask, RaycastHit &hit, const Collider *ignore = nullptr);
+
+        /**
+         * @brief Find the colliders overlapping a circle.
+         * @param center The center of the circle.
+         * @param radius The radius of the circle.
+         * @param layerMask Only colliders on these layers are considered.
+         * @param results Buffer receiving the colliders, in no particular order.
+         * @param capacity The number of elements in results.
+         * @return The number of colliders written.
+         */
+        std::size_t OverlapCircle(const Point &center, double radius, unsigned int layerMask,
+                                  Collider **results, std::size_t capacity);
+
+        /**
+         * @brief Find the colliders overlapping an axis-aligned box.
+         * @param center The center of the box.
+         * @param size The width (x) and height (y) of the box.
+         * @param layerMask Only colliders on these layers are considered.
+         * @param results Buffer receiving the colliders, in no particular order.
+         * @param capacity The number of elements in results.
+         * @return The number of colliders written.
+         */
+        std::size_t OverlapBox(const Point &center, const Point &size, unsigned int layerMask,
+                               Collider **results, std::size_t capacity);
+
+        /**
+         * @brief Find the k colliders nearest to a point, measured to their surface.
+         * @param point The point to search around.
+         * @param k The maximum number of colliders to report; results must hold k elements.
+         * @param maxDistance Colliders further away than this are ignored.
+         * @param layerMask Only colliders on these layers are considered.
+         * @param results Buffer receiving the colliders, nearest first.
+         * @return The number of colliders written.
+         */
+        std::size_t Nearest(const Point &point, std::size_t k, double maxDistance, unsigned int layerMask,
+                            Collider **results);
+
+    }
+
+}
+
+#endif // PHYSICS_H_
@@ -0,0 +1,37 @@
+#ifndef RECT_H_
+#define RECT_H_
+
+#include "Point.hpp"
+
+namespace spic {
+
+    /**
+     * @brief Struct representing an axis-aligned 2D rectangle.
+     * @details (x, y) is the corner with the smallest coordinates; width and
+     *          height extend from there in the positive direction.
+     */
+    struct Rect {
+        double x;
+        double y;
+        double width;
+        double height;
+
+        /**
+         * @brief Whether the point lies inside the rectangle (edges included).
+         */
+        bool Contains(const Point &point) const {
+            return point.x >= x && point.x <= x + width && point.y >= y && point.y <= y + height;
+        }
+
+        /**
+         * @brief Whether this rectangle and other share any area (touching edges count).
+         */
+        bool Overlaps(const Rect &other) const {
+            return x <= other.x + other.width && other.x <= x + width &&
+                   y <= other.y + other.height && other.y <= y + height;
+        }
+    };
+
+}
+
+#endif // RECT_H_
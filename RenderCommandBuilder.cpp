@@ -0,0 +1,131 @@
+#include "RenderCommandBuilder.hpp"
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief Write the four corners of a sprite quad, counter-clockwise from the top-left.
+     */
+    void WriteQuad(const SpriteInstance &instance, std::uint32_t color, SpriteVertex *quad) {
+        const Sprite &sprite = *instance.sprite;
+        const Transform &transform = instance.transform;
+        const double halfWidth = instance.width * transform.scale / 2;
+        const double halfHeight = instance.height * transform.scale / 2;
+        const double c = std::cos(transform.rotation);
+        const double s = std::sin(transform.rotation);
+
+        float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+        if (const AtlasRegion *region = instance.region ? instance.region : sprite.Region()) {
+            u0 = static_cast<float>(region->u0);
+            v0 = static_cast<float>(region->v0);
+            u1 = static_cast<float>(region->u1);
+            v1 = static_cast<float>(region->v1);
+        }
+        if (sprite.FlipX() != instance.flipX) std::swap(u0, u1);
+        if (sprite.FlipY() != instance.flipY) std::swap(v0, v1);
+
+        const double corners[4][2] = {{-halfWidth, -halfHeight}, {halfWidth, -halfHeight},
+                                      {halfWidth, halfHeight}, {-halfWidth, halfHeight}};
+        const float uvs[4][2] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+        for (int i = 0; i < 4; ++i) {
+            quad[i] = {static_cast<float>(transform.position.x + corners[i][0] * c - corners[i][1] * s),
+                       static_cast<float>(transform.position.y + corners[i][0] * s + corners[i][1] * c),
+                       uvs[i][0], uvs[i][1], color};
+        }
+    }
+
+}
+
+RenderCommandBuilder::RenderCommandBuilder(unsigned int threads, std::size_t chunkSize)
+    : threads {std::max(1u, threads)}, chunkSize {std::max<std::size_t>(1, chunkSize)},
+      allocators(this->threads) {}
+
+void RenderCommandBuilder::Build(const RenderQueue &queue, const SpriteInstance *instances,
+                                 std::vector<SpriteVertex> &vertices, std::vector<RenderCommand> &commands) {
+    const std::vector<RenderItem> &items = queue.Items();
+    const std::size_t chunkCount = (items.size() + chunkSize - 1) / chunkSize;
+    chunks.assign(chunkCount, Chunk {nullptr, 0, nullptr, 0});
+
+    // Sprite::Region fills its cache on first use; do that here, so the workers only read it.
+    for (const RenderItem &item: items) {
+        const SpriteInstance &instance = instances[item.handle];
+        if (instance.sprite != nullptr && instance.region == nullptr) instance.sprite->Region();
+    }
+
+    std::atomic<std::size_t> nextChunk {0};
+    auto work = [&](std::size_t part) {
+        LinearAllocator &allocator = allocators[part];
+        allocator.Reset();
+        for (std::size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+            const std::size_t first = chunk * chunkSize;
+            BuildChunk(items.data() + first, std::min(chunkSize, items.size() - first), instances, allocator,
+                       chunks[chunk]);
+        }
+    };
+
+    // One part per thread, each with an allocator of its own, taking chunks until none are left.
+    JobSystem &jobs = JobSystem::Shared();
+    const std::size_t parts = std::min<std::size_t>(std::min(threads, jobs.Threads()), chunkCount);
+    jobs.ParallelFor(parts, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t part = first; part < last; ++part) work(part);
+    });
+
+    std::size_t vertexCount = 0;
+    for (const Chunk &chunk: chunks) vertexCount += chunk.vertexCount;
+    vertices.resize(vertexCount);
+    commands.clear();
+
+    std::size_t offset = 0;
+    for (const Chunk &chunk: chunks) {
+        std::copy_n(chunk.vertices, chunk.vertexCount, vertices.begin() + static_cast<std::ptrdiff_t>(offset));
+
+        for (std::size_t i = 0; i < chunk.commandCount; ++i) {
+            RenderCommand command = chunk.commands[i];
+            command.firstVertex += offset;
+            // A run of one texture can span chunks; it is still a single draw call.
+            if (!commands.empty() && commands.back().texture == command.texture &&
+                commands.back().material == command.material) {
+                commands.back().vertexCount += command.vertexCount;
+            } else {
+                commands.push_back(command);
+            }
+        }
+
+        offset += chunk.vertexCount;
+    }
+}
+
+void RenderCommandBuilder::BuildChunk(const RenderItem *items, std::size_t count, const SpriteInstance *instances,
+                                      LinearAllocator &allocator, Chunk &chunk) const {
+    auto *vertices = allocator.Allocate<SpriteVertex>(count * 4);
+    auto *commands = allocator.Allocate<RenderCommand>(count);
+    std::size_t vertexCount = 0;
+    std::size_t commandCount = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const SpriteInstance &instance = instances[items[i].handle];
+        if (instance.sprite == nullptr) continue;
+
+        const std::uint32_t color = Color32(instance.sprite->SpriteColor()).rgba;
+        if (color >> 24 == 0) continue;
+
+        WriteQuad(instance, color, vertices + vertexCount);
+
+        const std::uint32_t texture = RenderQueue::TextureOf(items[i].key);
+        const std::uint32_t material = RenderQueue::MaterialOf(items[i].key);
+        if (commandCount > 0 && commands[commandCount - 1].texture == texture &&
+            commands[commandCount - 1].material == material) {
+            commands[commandCount - 1].vertexCount += 4;
+        } else {
+            commands[commandCount++] = {texture, material, vertexCount, 4};
+        }
+        vertexCount += 4;
+    }
+
+    chunk = {vertices, vertexCount, commands, commandCount};
+}
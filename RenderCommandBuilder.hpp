@@ -0,0 +1,126 @@
+#ifndef RENDERCOMMANDBUILDER_H_
+#define RENDERCOMMANDBUILDER_H_
+
+#include "LinearAllocator.hpp"
+#include "RenderQueue.hpp"
+#include "Sprite.hpp"
+#include "Transform.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief One corner of a sprite quad, as uploaded to the GPU.
+     */
+    struct SpriteVertex {
+        float x;
+        float y;
+        float u;
+        float v;
+        std::uint32_t color;
+    };
+
+    /**
+     * @brief A sprite to draw and where: the input of RenderCommandBuilder.
+     */
+    struct SpriteInstance {
+        /**
+         * @brief The sprite, or nullptr to draw nothing.
+         */
+        const Sprite *sprite;
+
+        /**
+         * @brief The world-space transform of the sprite's center.
+         */
+        Transform transform;
+
+        /**
+         * @brief The size of the sprite in world units, before scaling.
+         */
+        double width;
+        double height;
+
+        /**
+         * @brief The part of the texture to draw, such as an Animator's current frame, or
+         *        nullptr to use the sprite's own Region().
+         */
+        const AtlasRegion *region;
+
+        /**
+         * @brief Extra mirroring, such as an Animator's, on top of the sprite's own FlipX and FlipY.
+         */
+        bool flipX;
+        bool flipY;
+    };
+
+    /**
+     * @brief One draw call: a run of quads sharing texture and material.
+     */
+    struct RenderCommand {
+        std::uint32_t texture;
+        std::uint32_t material;
+
+        /**
+         * @brief Index of the first vertex; every quad is four consecutive vertices.
+         */
+        std::size_t firstVertex;
+        std::size_t vertexCount;
+    };
+
+    /**
+     * @brief Turns the sorted draws of a RenderQueue into a vertex buffer and draw calls, on
+     *        several threads.
+     * @details The draws are split into fixed-size chunks, which the threads of
+     *          JobSystem::Shared() pick up in any order. Each thread writes the vertices and draw
+     *          calls of its chunks into a LinearAllocator of its own, so threads never share
+     *          memory and nothing is allocated once the allocators have grown. The chunks are then merged in drawing order, joining draw
+     *          calls across chunk boundaries, which makes the result identical to building
+     *          everything on one thread.
+     */
+    class RenderCommandBuilder {
+    public:
+        /**
+         * @brief Constructor.
+         * @param threads The most threads of JobSystem::Shared() building chunks, at least 1.
+         * @param chunkSize The number of draws per chunk.
+         */
+        explicit RenderCommandBuilder(unsigned int threads = 1, std::size_t chunkSize = 1024);
+
+        /**
+         * @brief Build the vertices and draw calls of all draws in a sorted queue.
+         * @details Instances without a sprite, or whose sprite is fully transparent, produce
+         *          no quad.
+         * @param queue The queue, after RenderQueue::Sort().
+         * @param instances The sprites, indexed by the handles the queue's draws were added with.
+         * @param vertices Receives four vertices per quad, in drawing order; cleared first.
+         * @param commands Receives the draw calls, in drawing order; cleared first.
+         */
+        void Build(const RenderQueue &queue, const SpriteInstance *instances,
+                   std::vector<SpriteVertex> &vertices, std::vector<RenderCommand> &commands);
+
+    private:
+        /**
+         * @brief The output of one chunk, stored in the allocator of the thread that built it.
+         *        Its draw calls count vertices from the start of the chunk.
+         */
+        struct Chunk {
+            const SpriteVertex *vertices;
+            std::size_t vertexCount;
+            const RenderCommand *commands;
+            std::size_t commandCount;
+        };
+
+        void BuildChunk(const RenderItem *items, std::size_t count, const SpriteInstance *instances,
+                        LinearAllocator &allocator, Chunk &chunk) const;
+
+        unsigned int threads;
+        std::size_t chunkSize;
+        std::vector<LinearAllocator> allocators;
+        std::vector<Chunk> chunks;
+    };
+
+}
+
+#endif // RENDERCOMMANDBUILDER_H_
@@ -0,0 +1,166 @@
+#include "RenderQueue.hpp"
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief Use the incremental merge while at most one in this many draws changed.
+     */
+    constexpr std::size_t incrementalRatio = 16;
+
+    bool Before(const RenderItem &a, const RenderItem &b) {
+        return a.key < b.key || (a.key == b.key && a.handle < b.handle);
+    }
+
+    std::uint64_t Bias16(int value) {
+        return static_cast<std::uint64_t>(std::min(std::max(value, -0x8000), 0x7FFF) + 0x8000);
+    }
+
+}
+
+std::uint64_t RenderQueue::MakeKey(int sortingLayer, int orderInLayer, std::uint32_t texture, std::uint32_t material) {
+    return Bias16(sortingLayer) << 48 | Bias16(orderInLayer) << 32 |
+           static_cast<std::uint64_t>(texture & 0xFFFFFF) << 8 | (material & 0xFF);
+}
+
+std::uint64_t RenderQueue::KeyOf(const Sprite &sprite) {
+    // Sprites packed into an atlas share the texture of their page, and so end up in one batch.
+    const AtlasRegion *region = sprite.Region();
+    const std::uint32_t texture = TextureId(region ? TextureAtlas::PagePath(region->page) : sprite.SpriteSrc());
+    return MakeKey(sprite.SortingLayer(), sprite.OrderInLayer(), texture);
+}
+
+std::uint32_t RenderQueue::TextureId(const std::string &path) {
+    static std::unordered_map<std::string, std::uint32_t> ids;
+    return ids.emplace(path, static_cast<std::uint32_t>(ids.size())).first->second;
+}
+
+std::uint32_t RenderQueue::Add(std::uint64_t key) {
+    std::uint32_t handle;
+    if (freeHandles.empty()) {
+        handle = static_cast<std::uint32_t>(keys.size());
+        keys.push_back(key);
+        live.push_back(true);
+        changed.push_back(false);
+    } else {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+        keys[handle] = key;
+        live[handle] = true;
+    }
+
+    MarkChanged(handle);
+    return handle;
+}
+
+void RenderQueue::Update(std::uint32_t handle, std::uint64_t key) {
+    if (keys[handle] == key) return;
+
+    keys[handle] = key;
+    MarkChanged(handle);
+}
+
+void RenderQueue::Remove(std::uint32_t handle) {
+    if (!live[handle]) return;
+
+    live[handle] = false;
+    freeHandles.push_back(handle);
+    MarkChanged(handle);
+}
+
+void RenderQueue::Clear() {
+    keys.clear();
+    live.clear();
+    changed.clear();
+    freeHandles.clear();
+    changedHandles.clear();
+    items.clear();
+    batches.clear();
+}
+
+void RenderQueue::Sort() {
+    if (changedHandles.empty()) return;
+
+    lastSortIncremental = !items.empty() && changedHandles.size() * incrementalRatio <= items.size();
+    if (lastSortIncremental) {
+        MergeChanges();
+    } else {
+        RadixSort();
+    }
+
+    for (std::uint32_t handle: changedHandles) changed[handle] = false;
+    changedHandles.clear();
+
+    BuildBatches();
+}
+
+void RenderQueue::MarkChanged(std::uint32_t handle) {
+    if (changed[handle]) return;
+
+    changed[handle] = true;
+    changedHandles.push_back(handle);
+}
+
+void RenderQueue::RadixSort() {
+    // Listing the draws by handle makes handle the tie-breaker, since every pass is stable.
+    items.clear();
+    for (std::uint32_t handle = 0; handle < keys.size(); ++handle) {
+        if (live[handle]) items.push_back({keys[handle], handle});
+    }
+    scratch.resize(items.size());
+
+    std::array<std::array<std::size_t, 256>, 8> counts {};
+    for (const RenderItem &item: items) {
+        for (int pass = 0; pass < 8; ++pass) ++counts[pass][(item.key >> (pass * 8)) & 0xFF];
+    }
+
+    for (int pass = 0; pass < 8; ++pass) {
+        std::array<std::size_t, 256> &count = counts[pass];
+        // A byte that is the same in every key does not change the order; skip its pass.
+        if (std::any_of(count.begin(), count.end(), [&](std::size_t n) { return n == items.size(); })) continue;
+
+        std::size_t offset = 0;
+        for (std::size_t &n: count) {
+            const std::size_t bucket = n;
+            n = offset;
+            offset += bucket;
+        }
+        for (const RenderItem &item: items) scratch[count[(item.key >> (pass * 8)) & 0xFF]++] = item;
+        items.swap(scratch);
+    }
+}
+
+void RenderQueue::MergeChanges() {
+    scratch.clear();
+    for (const RenderItem &item: items) {
+        if (!changed[item.handle]) scratch.push_back(item);
+    }
+
+    const auto kept = static_cast<std::ptrdiff_t>(scratch.size());
+    for (std::uint32_t handle: changedHandles) {
+        if (live[handle]) scratch.push_back({keys[handle], handle});
+    }
+    std::sort(scratch.begin() + kept, scratch.end(), Before);
+
+    items.resize(scratch.size());
+    std::merge(scratch.begin(), scratch.begin() + kept, scratch.begin() + kept, scratch.end(), items.begin(), Before);
+}
+
+void RenderQueue::BuildBatches() {
+    batches.clear();
+
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        const std::uint32_t texture = TextureOf(items[i].key);
+        const std::uint32_t material = MaterialOf(items[i].key);
+
+        if (!batches.empty() && batches.back().texture == texture && batches.back().material == material) {
+            ++batches.back().count;
+        } else {
+            batches.push_back({texture, material, i, 1});
+        }
+    }
+}
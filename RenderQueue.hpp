@@ -0,0 +1,148 @@
+#ifndef RENDERQUEUE_H_
+#define RENDERQUEUE_H_
+
+#include "Sprite.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief One draw in a RenderQueue: its sort key and the handle it was added with.
+     */
+    struct RenderItem {
+        std::uint64_t key;
+        std::uint32_t handle;
+    };
+
+    /**
+     * @brief A run of consecutive sorted draws sharing texture and material, which can be
+     *        submitted as a single instanced draw call.
+     */
+    struct DrawBatch {
+        std::uint32_t texture;
+        std::uint32_t material;
+
+        /**
+         * @brief Index of the first draw of the batch in RenderQueue::Items().
+         */
+        std::size_t first;
+
+        /**
+         * @brief The number of draws in the batch.
+         */
+        std::size_t count;
+    };
+
+    /**
+     * @brief Orders the draws of a frame and groups them into batches.
+     * @details Every draw is described by a 64-bit key; sorting the keys gives the draw order
+     *          and puts draws with the same texture next to each other. The queue keeps its
+     *          draws between frames: when only a few keys changed since the last Sort(), the
+     *          changed ones are sorted separately and merged into the previous order, otherwise
+     *          all keys are radix sorted again.
+     */
+    class RenderQueue {
+    public:
+        /**
+         * @brief Build a sort key. From most to least significant: sorting layer (16 bits),
+         *        order in layer (16 bits), texture (24 bits) and material (8 bits).
+         * @param sortingLayer The sorting layer, clamped to the range of a 16-bit integer.
+         * @param orderInLayer The order within the layer, clamped to the range of a 16-bit integer.
+         * @param texture A texture id from TextureId().
+         * @param material A material id, 0 for the default material.
+         */
+        static std::uint64_t MakeKey(int sortingLayer, int orderInLayer, std::uint32_t texture,
+                                     std::uint32_t material = 0);
+
+        /**
+         * @brief Build the sort key of a sprite.
+         */
+        static std::uint64_t KeyOf(const Sprite &sprite);
+
+        static std::uint32_t TextureOf(std::uint64_t key) { return static_cast<std::uint32_t>(key >> 8) & 0xFFFFFF; }
+
+        static std::uint32_t MaterialOf(std::uint64_t key) { return static_cast<std::uint32_t>(key) & 0xFF; }
+
+        /**
+         * @brief Get the small integer id of a texture path, assigning a new one on first use.
+         */
+        static std::uint32_t TextureId(const std::string &path);
+
+        /**
+         * @brief Add a draw to the queue.
+         * @param key The draw's sort key.
+         * @return A handle for updating or removing the draw later.
+         */
+        std::uint32_t Add(std::uint64_t key);
+
+        /**
+         * @brief Change the sort key of a draw. Does nothing if the key did not change.
+         */
+        void Update(std::uint32_t handle, std::uint64_t key);
+
+        /**
+         * @brief Remove a draw. Its handle may be handed out again by a later Add.
+         */
+        void Remove(std::uint32_t handle);
+
+        /**
+         * @brief Remove all draws.
+         */
+        void Clear();
+
+        /**
+         * @brief Bring Items() and Batches() up to date with all changes since the last call.
+         */
+        void Sort();
+
+        /**
+         * @brief The draws in drawing order, as of the last Sort(). Draws with equal keys are
+         *        ordered by handle.
+         */
+        [[nodiscard]] const std::vector<RenderItem> &Items() const { return items; }
+
+        /**
+         * @brief The batches covering Items(), as of the last Sort().
+         */
+        [[nodiscard]] const std::vector<DrawBatch> &Batches() const { return batches; }
+
+        /**
+         * @brief Whether the last Sort() merged changes instead of sorting everything.
+         */
+        [[nodiscard]] bool LastSortWasIncremental() const { return lastSortIncremental; }
+
+    private:
+        void MarkChanged(std::uint32_t handle);
+
+        void RadixSort();
+
+        void MergeChanges();
+
+        void BuildBatches();
+
+        /**
+         * @brief Current key per handle.
+         */
+        std::vector<std::uint64_t> keys;
+
+        /**
+         * @brief Per handle: whether the draw exists and whether it changed since the last Sort().
+         */
+        std::vector<bool> live;
+        std::vector<bool> changed;
+
+        std::vector<std::uint32_t> freeHandles;
+        std::vector<std::uint32_t> changedHandles;
+
+        std::vector<RenderItem> items;
+        std::vector<RenderItem> scratch;
+        std::vector<DrawBatch> batches;
+        bool lastSortIncremental {false};
+    };
+
+}
+
+#endif // RENDERQUEUE_H_
@@ -0,0 +1,105 @@
+#include "ResourceCache.hpp"
+
+using namespace spic;
+
+ResourceCache::ResourceCache(std::size_t budget) : budget {budget} {}
+
+void ResourceCache::Loader(ResourceType type, LoadFunction load) {
+    std::lock_guard<std::mutex> lock {mutex};
+    loaders[static_cast<std::size_t>(type)] = std::move(load);
+}
+
+void ResourceCache::Budget(std::size_t newBudget) {
+    std::lock_guard<std::mutex> lock {mutex};
+    budget = newBudget;
+    TrimLocked();
+}
+
+std::size_t ResourceCache::Budget() const {
+    std::lock_guard<std::mutex> lock {mutex};
+    return budget;
+}
+
+ResourceCache::ResourceId ResourceCache::Intern(const std::string &path) {
+    std::lock_guard<std::mutex> lock {mutex};
+    auto inserted = ids.emplace(path, static_cast<ResourceId>(paths.size()));
+    if (inserted.second) paths.push_back(path);
+    return inserted.first->second;
+}
+
+std::string ResourceCache::Path(ResourceId id) const {
+    std::lock_guard<std::mutex> lock {mutex};
+    return paths.at(id);
+}
+
+void ResourceCache::Trim() {
+    std::lock_guard<std::mutex> lock {mutex};
+    TrimLocked();
+}
+
+std::size_t ResourceCache::Bytes() const {
+    std::lock_guard<std::mutex> lock {mutex};
+    return bytes;
+}
+
+ResourceStats ResourceCache::Stats(ResourceType type) const {
+    std::lock_guard<std::mutex> lock {mutex};
+    return stats[static_cast<std::size_t>(type)];
+}
+
+std::shared_ptr<void> ResourceCache::GetErased(ResourceType type, ResourceId id) {
+    const std::uint64_t key = Key(type, id);
+    ResourceStats &typeStats = stats[static_cast<std::size_t>(type)];
+    LoadFunction load;
+    std::string path;
+
+    {
+        std::lock_guard<std::mutex> lock {mutex};
+        auto found = entries.find(key);
+        if (found != entries.end()) {
+            ++typeStats.hits;
+            recency.splice(recency.begin(), recency, found->second.recency);
+            return found->second.resource;
+        }
+
+        ++typeStats.misses;
+        load = loaders[static_cast<std::size_t>(type)];
+        path = paths.at(id);
+    }
+
+    if (!load) return nullptr;
+
+    // Load without holding the lock, so slow files do not block requests for cached ones.
+    std::size_t size = 0;
+    std::shared_ptr<void> resource = load(path, size);
+    if (resource == nullptr) return nullptr;
+
+    std::lock_guard<std::mutex> lock {mutex};
+    auto inserted = entries.emplace(key, Entry {resource, size, type, {}});
+    if (!inserted.second) {
+        // Another thread loaded it in the meantime; keep that copy so there is only one.
+        return inserted.first->second.resource;
+    }
+
+    recency.push_front(key);
+    inserted.first->second.recency = recency.begin();
+    bytes += size;
+    TrimLocked();
+
+    return resource;
+}
+
+void ResourceCache::TrimLocked() {
+    for (auto it = recency.end(); bytes > budget && it != recency.begin();) {
+        --it;
+        auto entry = entries.find(*it);
+
+        // The cache's own reference is the only one left: nobody uses the resource.
+        if (entry->second.resource.use_count() == 1) {
+            bytes -= entry->second.bytes;
+            ++stats[static_cast<std::size_t>(entry->second.type)].evictions;
+            entries.erase(entry);
+            it = recency.erase(it);
+        }
+    }
+}
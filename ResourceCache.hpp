@@ -0,0 +1,157 @@
+#ifndef RESOURCECACHE_H_
+#define RESOURCECACHE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief The kinds of resources the engine loads from files.
+     */
+    enum class ResourceType {
+        texture,
+        font,
+        audio
+    };
+
+    /**
+     * @brief Counters for one ResourceType.
+     */
+    struct ResourceStats {
+        /**
+         * @brief Requests answered from the cache.
+         */
+        std::size_t hits;
+
+        /**
+         * @brief Requests that had to load the file.
+         */
+        std::size_t misses;
+
+        /**
+         * @brief Resources dropped to stay within the memory budget.
+         */
+        std::size_t evictions;
+    };
+
+    /**
+     * @brief Shares loaded resources (Sprite::SpriteSrc, Text::Font, AudioSource::AudioClip, ...)
+     *        between everything that refers to the same path.
+     * @details Paths are interned to small integer ids. Resources are handed out as
+     *          std::shared_ptr, which serves as the reference count: as long as anyone holds
+     *          one the resource stays loaded. Resources nobody holds stay cached until the memory
+     *          budget is exceeded, and are then evicted least recently used first.
+     *          All functions may be called from any thread.
+     */
+    class ResourceCache {
+    public:
+        using ResourceId = std::uint32_t;
+
+        /**
+         * @brief Loads a resource from a file.
+         * @details Called with the path and a reference through which the loader reports the
+         *          memory size of what it loaded. Returns nullptr when the file cannot be loaded.
+         */
+        using LoadFunction = std::function<std::shared_ptr<void>(const std::string &path, std::size_t &bytes)>;
+
+        /**
+         * @brief Constructor.
+         * @param budget The number of bytes unused resources may occupy before they are evicted.
+         */
+        explicit ResourceCache(std::size_t budget);
+
+        /**
+         * @brief Register the function that loads resources of a type.
+         */
+        void Loader(ResourceType type, LoadFunction load);
+
+        /**
+         * @brief Change the memory budget, evicting unused resources if needed.
+         */
+        void Budget(std::size_t newBudget);
+
+        [[nodiscard]] std::size_t Budget() const;
+
+        /**
+         * @brief Get the id of a path, assigning a new one on first use.
+         */
+        ResourceId Intern(const std::string &path);
+
+        /**
+         * @brief The path an id was interned from.
+         */
+        [[nodiscard]] std::string Path(ResourceId id) const;
+
+        /**
+         * @brief Get a resource, loading it if it is not cached.
+         * @tparam T The type the loader of this ResourceType produces.
+         * @return The resource, or nullptr if it could not be loaded.
+         */
+        template<class T>
+        std::shared_ptr<T> Get(ResourceType type, const std::string &path) {
+            return std::static_pointer_cast<T>(GetErased(type, Intern(path)));
+        }
+
+        /**
+         * @brief Get a resource by interned id, loading it if it is not cached.
+         */
+        template<class T>
+        std::shared_ptr<T> Get(ResourceType type, ResourceId id) {
+            return std::static_pointer_cast<T>(GetErased(type, id));
+        }
+
+        /**
+         * @brief Evict unused resources until the cache fits its budget.
+         */
+        void Trim();
+
+        /**
+         * @brief The memory size of all cached resources, used or not.
+         */
+        [[nodiscard]] std::size_t Bytes() const;
+
+        [[nodiscard]] ResourceStats Stats(ResourceType type) const;
+
+    private:
+        struct Entry {
+            std::shared_ptr<void> resource;
+            std::size_t bytes;
+            ResourceType type;
+
+            /**
+             * @brief Position in the recency list, most recently used at the front.
+             */
+            std::list<std::uint64_t>::iterator recency;
+        };
+
+        static std::uint64_t Key(ResourceType type, ResourceId id) {
+            return static_cast<std::uint64_t>(type) << 32 | id;
+        }
+
+        std::shared_ptr<void> GetErased(ResourceType type, ResourceId id);
+
+        void TrimLocked();
+
+        mutable std::mutex mutex;
+        std::size_t budget;
+        std::size_t bytes {0};
+        std::array<LoadFunction, 3> loaders;
+        std::array<ResourceStats, 3> stats {};
+        std::unordered_map<std::string, ResourceId> ids;
+        std::vector<std::string> paths;
+        std::unordered_map<std::uint64_t, Entry> entries;
+        std::list<std::uint64_t> recency;
+    };
+
+}
+
+#endif // RESOURCECACHE_H_
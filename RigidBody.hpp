@@ -40,12 +40,29 @@ namespace spic {
 
         [[nodiscard]] spic::BodyType BodyTypeRB() const;
 
+        /**
+         * @brief Mark this body as a bullet: a small, fast dynamic body that uses continuous
+         *        collision detection.
+         * @details The flag asks the physics step to move this body with continuous collision,
+         *          a swept test such as Physics::CircleCast or Physics::BoxCast from its previous to
+         *          its new position, so it cannot tunnel through thin colliders. The flag only
+         *          records the request; the engine's physics step has to act on it.
+         * @param newBullet true to enable continuous collision detection.
+         */
+        void Bullet(bool newBullet) { bullet = newBullet; }
+
+        /**
+         * @brief Whether this body uses continuous collision detection.
+         */
+        [[nodiscard]] bool Bullet() const { return bullet; }
+
         RigidBody(double mass, double gravityScale, spic::BodyType bodyType);
 
     private:
         double mass;
         double gravityScale;
         BodyType bodyType;
+        bool bullet {false};
     };
 
 }
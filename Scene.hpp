@@ -12,6 +12,14 @@ namespace spic {
     public:
         /**
          * @brief This function is called by a Camera to render the scene on the engine.
+         * @details A Culler picks the objects inside the Camera's ViewRect(); only their
+         *          sprites are submitted to a RenderQueue, which orders them by sorting layer,
+         *          order in layer and texture, and draws sprites sharing a texture as one batch.
+         *          Their vertices and draw calls are built on worker threads by a
+         *          RenderCommandBuilder.
+         *          Texts are drawn as glyph quads from their font's GlyphAtlas, using layouts
+         *          from a TextLayoutCache. UI objects are drawn into a UILayer, which repaints
+         *          only the parts that changed, and composited over the scene.
          * @spicapi
          */
         void RenderScene();
@@ -0,0 +1,126 @@
+#include "ScriptScheduler.hpp"
+#include <algorithm>
+
+using namespace spic;
+
+ScriptScheduler::ScriptScheduler(JobSystem &jobs, std::size_t grain) : jobs {jobs}, grain {grain} {}
+
+void ScriptScheduler::Add(BehaviourScript &script) {
+    Register(script, &UpdateVirtual);
+}
+
+void ScriptScheduler::Remove(const BehaviourScript &script) {
+    const auto removed = std::remove_if(scripts.begin(), scripts.end(), [&script](const Entry &entry) {
+        return entry.script == &script;
+    });
+    if (removed == scripts.end()) return;
+
+    scripts.erase(removed, scripts.end());
+    dirty = true;
+}
+
+void ScriptScheduler::Update() {
+    if (dirty) Rebuild();
+
+    for (const Group &group: mainThread) group.update(group.scripts.data(), group.scripts.size());
+
+    for (const Batch &batch: batches) {
+        jobs.ParallelFor(batch.ranges.size(), 1, [&batch](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                const Range &range = batch.ranges[i];
+                range.group->update(range.group->scripts.data() + range.first, range.last - range.first);
+            }
+        });
+    }
+}
+
+std::size_t ScriptScheduler::MainThreadScripts() {
+    if (dirty) Rebuild();
+
+    std::size_t count = 0;
+    for (const Group &group: mainThread) count += group.scripts.size();
+    return count;
+}
+
+std::size_t ScriptScheduler::Batches() {
+    if (dirty) Rebuild();
+    return batches.size();
+}
+
+void ScriptScheduler::UpdateVirtual(BehaviourScript *const *scripts, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (scripts[i]->Active()) scripts[i]->OnUpdate();
+    }
+}
+
+void ScriptScheduler::Insert(std::vector<Group> &groups, const Entry &entry) {
+    const std::type_index type {typeid(*entry.script)};
+    auto group = std::find_if(groups.begin(), groups.end(), [&](const Group &candidate) {
+        return candidate.type == type && candidate.update == entry.update;
+    });
+    if (group == groups.end()) group = groups.insert(groups.end(), Group {type, entry.update, {}});
+    group->scripts.push_back(entry.script);
+}
+
+void ScriptScheduler::Register(BehaviourScript &script, Dispatch update) {
+    scripts.push_back({&script, update});
+    dirty = true;
+}
+
+void ScriptScheduler::Rebuild() {
+    mainThread.clear();
+    batches.clear();
+
+    auto any = [](const std::vector<std::type_index> &types, const std::unordered_set<std::type_index> &set) {
+        return std::any_of(types.begin(), types.end(), [&set](const std::type_index &type) { return set.count(type) > 0; });
+    };
+
+    // Types written on another object still conflict with whoever reads or writes them anywhere.
+    auto anyOwn = [](const std::vector<std::type_index> &types, const Batch &batch) {
+        return std::any_of(types.begin(), types.end(), [&batch](const std::type_index &type) {
+            return batch.writesOwn.count(type) > 0;
+        });
+    };
+
+    // Greedy: every script goes into the first batch it does not conflict with.
+    for (const Entry &entry: scripts) {
+        ScriptAccess access = entry.script->Access();
+        if (!access.Parallel()) {
+            Insert(mainThread, entry);
+            continue;
+        }
+        if (access.owner == nullptr) {
+            access.writes.insert(access.writes.end(), access.writesOwn.begin(), access.writesOwn.end());
+            access.writesOwn.clear();
+        }
+
+        auto batch = std::find_if(batches.begin(), batches.end(), [&](const Batch &candidate) {
+            if (any(access.writes, candidate.writes) || any(access.writes, candidate.reads) ||
+                any(access.reads, candidate.writes) || anyOwn(access.writes, candidate) ||
+                anyOwn(access.reads, candidate)) return false;
+            return std::none_of(access.writesOwn.begin(), access.writesOwn.end(), [&](const std::type_index &type) {
+                const auto owners = candidate.writesOwn.find(type);
+                return candidate.writes.count(type) > 0 || candidate.reads.count(type) > 0 ||
+                       (owners != candidate.writesOwn.end() && owners->second.count(access.owner) > 0);
+            });
+        });
+        if (batch == batches.end()) batch = batches.emplace(batches.end());
+
+        Insert(batch->groups, entry);
+        batch->reads.insert(access.reads.begin(), access.reads.end());
+        batch->writes.insert(access.writes.begin(), access.writes.end());
+        for (const std::type_index &type: access.writesOwn) batch->writesOwn[type].insert(access.owner);
+    }
+
+    // Cut once the groups are complete, so the ranges point at their final place.
+    const std::size_t size = std::max<std::size_t>(grain, 1);
+    for (Batch &batch: batches) {
+        for (const Group &group: batch.groups) {
+            for (std::size_t first = 0; first < group.scripts.size(); first += size) {
+                batch.ranges.push_back({&group, first, std::min(group.scripts.size(), first + size)});
+            }
+        }
+    }
+
+    dirty = false;
+}
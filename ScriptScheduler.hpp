@@ -0,0 +1,153 @@
+#ifndef SCRIPTSCHEDULER_H_
+#define SCRIPTSCHEDULER_H_
+
+#include "BehaviourScript.hpp"
+#include "JobSystem.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Whether T has an OnUpdate of its own or from a base between it and BehaviourScript.
+     */
+    template<class T>
+    constexpr bool OverridesOnUpdate = !std::is_same_v<decltype(&T::OnUpdate), void (BehaviourScript::*)()>;
+
+    /**
+     * @brief Calls OnUpdate of all scripts once per frame, in parallel where their declared
+     *        BehaviourScript::Access allows.
+     * @details Scripts that declare nothing run one by one on the calling thread, first. The
+     *          others are grouped into batches of scripts that do not conflict: no two scripts in
+     *          a batch write a type, or one writes a type the other reads, except that types in
+     *          ScriptAccess::writesOwn only conflict on the same owner. Batches run one after
+     *          another, each as one parallel loop over the JobSystem: its groups are cut into
+     *          pieces of at most grain scripts, and the pieces of all groups are spread over the
+     *          threads together. Batches are rebuilt after scripts are added or removed.
+     *
+     *          Conflicts are tracked per component type, not per component: scripts that each
+     *          write the Transform of their own object, but declare it in writes, all conflict and
+     *          end up in batches of one script each, which run one after another on the calling
+     *          thread. Declare such types in writesOwn, with the owner, to run them together.
+     *
+     *          Within the main thread and each batch, scripts are grouped by their concrete type
+     *          and each group is updated in one loop, in the order the scripts were added. Scripts
+     *          added through Add<T> are called without virtual dispatch, and are not called at all
+     *          when T does not override OnUpdate.
+     */
+    class ScriptScheduler {
+    public:
+        /**
+         * @brief Constructor.
+         * @param jobs The pool running the batches. Must outlive the scheduler.
+         * @param grain The smallest number of scripts handed to one thread at a time.
+         */
+        explicit ScriptScheduler(JobSystem &jobs = JobSystem::Shared(), std::size_t grain = 64);
+
+        ScriptScheduler(const ScriptScheduler &other) = delete;
+
+        ScriptScheduler &operator=(const ScriptScheduler &other) = delete;
+
+        /**
+         * @brief Add a script whose concrete type is T, which must stay alive until it is removed.
+         * @details A script of a type derived from T is added as by the non-template Add.
+         */
+        template<class T>
+        void Add(T &script) {
+            static_assert(std::is_base_of_v<BehaviourScript, T>, "T must be a BehaviourScript");
+            if (typeid(script) != typeid(T)) {
+                Add(static_cast<BehaviourScript &>(script));
+            } else if constexpr (OverridesOnUpdate<T>) {
+                Register(script, &UpdateAll<T>);
+            }
+        }
+
+        /**
+         * @brief Add a script, which must stay alive until it is removed.
+         * @details Its OnUpdate is called virtually, grouped with the other scripts of its type.
+         */
+        void Add(BehaviourScript &script);
+
+        void Remove(const BehaviourScript &script);
+
+        /**
+         * @brief Call OnUpdate of every active script.
+         */
+        void Update();
+
+        /**
+         * @brief The number of scripts running on the main thread.
+         */
+        [[nodiscard]] std::size_t MainThreadScripts();
+
+        /**
+         * @brief The number of parallel batches.
+         */
+        [[nodiscard]] std::size_t Batches();
+
+    private:
+        /**
+         * @brief Updates count scripts of one type.
+         */
+        using Dispatch = void (*)(BehaviourScript *const *scripts, std::size_t count);
+
+        struct Group {
+            std::type_index type;
+            Dispatch update;
+            std::vector<BehaviourScript *> scripts;
+        };
+
+        /**
+         * @brief The scripts [first, last) of a group, run by one thread.
+         */
+        struct Range {
+            const Group *group;
+            std::size_t first;
+            std::size_t last;
+        };
+
+        struct Batch {
+            std::vector<Group> groups;
+            std::vector<Range> ranges;
+            std::unordered_set<std::type_index> reads;
+            std::unordered_set<std::type_index> writes;
+            std::unordered_map<std::type_index, std::unordered_set<const GameObject *>> writesOwn;
+        };
+
+        struct Entry {
+            BehaviourScript *script;
+            Dispatch update;
+        };
+
+        template<class T>
+        static void UpdateAll(BehaviourScript *const *scripts, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                T *script = static_cast<T *>(scripts[i]);
+                if (script->Active()) script->T::OnUpdate();
+            }
+        }
+
+        static void UpdateVirtual(BehaviourScript *const *scripts, std::size_t count);
+
+        static void Insert(std::vector<Group> &groups, const Entry &entry);
+
+        void Register(BehaviourScript &script, Dispatch update);
+
+        void Rebuild();
+
+        JobSystem &jobs;
+        std::size_t grain;
+        std::vector<Entry> scripts;
+        bool dirty {false};
+        std::vector<Group> mainThread;
+        std::vector<Batch> batches;
+    };
+
+}
+
+#endif // SCRIPTSCHEDULER_H_
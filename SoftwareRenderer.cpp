@@ -0,0 +1,495 @@
+#include "SoftwareRenderer.hpp"
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+using namespace spic;
+
+namespace {
+
+    std::uint32_t Div255(std::uint32_t x) {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    /**
+     * @brief Blend one pixel over another. The source is first multiplied by tint; the result is
+     *        color = src * a + dst * (1 - a) and alpha = a + dstAlpha * (1 - a). A premultiplied
+     *        source already holds src * a, so its color is taken as is.
+     */
+    std::uint32_t BlendPixel(std::uint32_t destination, std::uint32_t source, std::uint32_t tint, bool premultiplied) {
+        const std::uint32_t alpha = Div255((source >> 24) * (tint >> 24));
+        std::uint32_t result = 0;
+
+        for (int shift = 0; shift < 24; shift += 8) {
+            const std::uint32_t s = Div255(((source >> shift) & 0xFF) * ((tint >> shift) & 0xFF));
+            const std::uint32_t d = (destination >> shift) & 0xFF;
+            result |= Div255(s * (premultiplied ? 255 : alpha) + d * (255 - alpha)) << shift;
+        }
+
+        return result | Div255(alpha * 255 + (destination >> 24) * (255 - alpha)) << 24;
+    }
+
+#if defined(__AVX2__)
+
+    __m256i Div255(__m256i x) {
+        x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    /**
+     * @brief BlendPixel for two pixels widened to 16 bits per channel, twice (one per 128-bit lane).
+     */
+    __m256i BlendWide(__m256i source, __m256i destination, __m256i tint, __m256i opaqueLanes) {
+        const __m256i v255 = _mm256_set1_epi16(255);
+
+        source = Div255(_mm256_mullo_epi16(source, tint));
+        const __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(source, 0xFF), 0xFF);
+        const __m256i sourceFactor = _mm256_or_si256(_mm256_andnot_si256(opaqueLanes, alpha),
+                                                     _mm256_and_si256(opaqueLanes, v255));
+
+        return Div255(_mm256_add_epi16(_mm256_mullo_epi16(source, sourceFactor),
+                                       _mm256_mullo_epi16(destination, _mm256_sub_epi16(v255, alpha))));
+    }
+
+    void BlendRow(std::uint32_t *destination, const std::uint32_t *source, std::size_t count, std::uint32_t tint,
+                  bool premultiplied) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i tints = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(tint)), zero);
+        // The lanes whose source is not multiplied by alpha: only alpha itself, or all when premultiplied.
+        const __m256i opaqueLanes = premultiplied ? _mm256_set1_epi16(-1)
+                                                  : _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8) {
+            const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+            const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+            const __m256i low = BlendWide(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), tints,
+                                          opaqueLanes);
+            const __m256i high = BlendWide(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), tints,
+                                           opaqueLanes);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_packus_epi16(low, high));
+        }
+        for (; i < count; ++i) destination[i] = BlendPixel(destination[i], source[i], tint, premultiplied);
+    }
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+    __m128i Div255(__m128i x) {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    /**
+     * @brief BlendPixel for two pixels widened to 16 bits per channel.
+     */
+    __m128i BlendWide(__m128i source, __m128i destination, __m128i tint, __m128i opaqueLanes) {
+        const __m128i v255 = _mm_set1_epi16(255);
+
+        source = Div255(_mm_mullo_epi16(source, tint));
+        const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(source, 0xFF), 0xFF);
+        const __m128i sourceFactor = _mm_or_si128(_mm_andnot_si128(opaqueLanes, alpha), _mm_and_si128(opaqueLanes, v255));
+
+        return Div255(_mm_add_epi16(_mm_mullo_epi16(source, sourceFactor),
+                                    _mm_mullo_epi16(destination, _mm_sub_epi16(v255, alpha))));
+    }
+
+    void BlendRow(std::uint32_t *destination, const std::uint32_t *source, std::size_t count, std::uint32_t tint,
+                  bool premultiplied) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i tints = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(tint)), zero);
+        // The lanes whose source is not multiplied by alpha: only alpha itself, or all when premultiplied.
+        const __m128i opaqueLanes = premultiplied ? _mm_set1_epi16(-1) : _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4) {
+            const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+            const __m128i low = BlendWide(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), tints, opaqueLanes);
+            const __m128i high = BlendWide(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), tints, opaqueLanes);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_packus_epi16(low, high));
+        }
+        for (; i < count; ++i) destination[i] = BlendPixel(destination[i], source[i], tint, premultiplied);
+    }
+
+#else
+
+    void BlendRow(std::uint32_t *destination, const std::uint32_t *source, std::size_t count, std::uint32_t tint,
+                  bool premultiplied) {
+        for (std::size_t i = 0; i < count; ++i) destination[i] = BlendPixel(destination[i], source[i], tint, premultiplied);
+    }
+
+#endif
+
+    std::uint32_t Crc32(const unsigned char *data, std::size_t size, std::uint32_t crc = 0) {
+        static const auto table = [] {
+            std::vector<std::uint32_t> entries(256);
+            for (std::uint32_t n = 0; n < 256; ++n) {
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; ++k) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                entries[n] = c;
+            }
+            return entries;
+        }();
+
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void PutBigEndian(std::vector<unsigned char> &out, std::uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<unsigned char>(value >> shift));
+    }
+
+    void WriteChunk(std::ofstream &out, const char *type, const std::vector<unsigned char> &data) {
+        std::vector<unsigned char> chunk;
+        PutBigEndian(chunk, static_cast<std::uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        PutBigEndian(chunk, Crc32(chunk.data() + 4, chunk.size() - 4));
+        out.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    }
+
+    void WriteRgbaPng(const std::string &path, int width, int height, const std::vector<std::uint32_t> &pixels) {
+        std::ofstream out {path, std::ios::binary};
+        if (!out) throw std::runtime_error("Cannot write '" + path + "'");
+
+        const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        out.write(reinterpret_cast<const char *>(signature), sizeof signature);
+
+        std::vector<unsigned char> header;
+        PutBigEndian(header, static_cast<std::uint32_t>(width));
+        PutBigEndian(header, static_cast<std::uint32_t>(height));
+        header.insert(header.end(), {8, 6, 0, 0, 0}); // 8 bits per channel, RGBA, no interlacing
+        WriteChunk(out, "IHDR", header);
+
+        // Every row starts with filter type 0 (none), followed by the RGBA bytes.
+        std::vector<unsigned char> raw;
+        raw.reserve(static_cast<std::size_t>(height) * (width * 4 + 1));
+        for (int y = 0; y < height; ++y) {
+            raw.push_back(0);
+            for (int x = 0; x < width; ++x) {
+                const std::uint32_t pixel = pixels[static_cast<std::size_t>(y) * width + x];
+                for (int shift = 0; shift < 32; shift += 8) raw.push_back(static_cast<unsigned char>(pixel >> shift));
+            }
+        }
+
+        // A zlib stream of stored (uncompressed) deflate blocks.
+        std::vector<unsigned char> data {0x78, 0x01};
+        std::uint32_t adlerA = 1;
+        std::uint32_t adlerB = 0;
+        for (std::size_t offset = 0; offset < raw.size() || offset == 0; offset += 0xFFFF) {
+            const auto size = static_cast<std::uint16_t>(std::min<std::size_t>(0xFFFF, raw.size() - offset));
+            data.push_back(offset + size >= raw.size() ? 1 : 0);
+            data.insert(data.end(), {static_cast<unsigned char>(size & 0xFF), static_cast<unsigned char>(size >> 8),
+                                     static_cast<unsigned char>(~size & 0xFF),
+                                     static_cast<unsigned char>(~size >> 8 & 0xFF)});
+            data.insert(data.end(), raw.begin() + static_cast<std::ptrdiff_t>(offset),
+                        raw.begin() + static_cast<std::ptrdiff_t>(offset + size));
+            if (raw.empty()) break;
+        }
+        for (unsigned char byte: raw) {
+            adlerA = (adlerA + byte) % 65521;
+            adlerB = (adlerB + adlerA) % 65521;
+        }
+        PutBigEndian(data, adlerB << 16 | adlerA);
+        WriteChunk(out, "IDAT", data);
+        WriteChunk(out, "IEND", {});
+
+        if (!out) throw std::runtime_error("Cannot write '" + path + "'");
+    }
+
+}
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, unsigned int threads, int tileSize)
+    : width {width}, height {height}, threads {std::max(1u, threads)}, tileSize {tileSize},
+      tilesX {(width + tileSize - 1) / tileSize}, tilesY {(height + tileSize - 1) / tileSize},
+      clip {0, 0, width, height}, pixels(static_cast<std::size_t>(width) * height, 0) {}
+
+void SoftwareRenderer::Clear(const Color &color) {
+    commands.clear();
+    std::fill(pixels.begin(), pixels.end(), Color32(color).rgba);
+}
+
+void SoftwareRenderer::Clip(const Rect &area) {
+    clip = {std::max(0, static_cast<int>(std::floor(area.x))), std::max(0, static_cast<int>(std::floor(area.y))),
+            std::min(width, static_cast<int>(std::ceil(area.x + area.width))),
+            std::min(height, static_cast<int>(std::ceil(area.y + area.height)))};
+}
+
+void SoftwareRenderer::ClearClip() {
+    clip = {0, 0, width, height};
+}
+
+void SoftwareRenderer::Fill(const Rect &area, const Color &color) {
+    Command command {};
+    command.type = CommandType::fill;
+    command.x = static_cast<int>(std::lround(area.x));
+    command.y = static_cast<int>(std::lround(area.y));
+    command.width = static_cast<int>(std::lround(area.x + area.width)) - command.x;
+    command.height = static_cast<int>(std::lround(area.y + area.height)) - command.y;
+    command.color = Color32(color).rgba;
+
+    if (command.width > 0 && command.height > 0) Record(command);
+}
+
+void SoftwareRenderer::DrawTexture(const SoftwareTexture &texture, const Rect &source, const Rect &destination,
+                                   bool flipX, bool flipY, const Color &tint) {
+    Command command {};
+    command.type = CommandType::texture;
+    command.texture = &texture;
+    command.sourceX = static_cast<int>(std::lround(source.x));
+    command.sourceY = static_cast<int>(std::lround(source.y));
+    command.sourceWidth = static_cast<int>(std::lround(source.width));
+    command.sourceHeight = static_cast<int>(std::lround(source.height));
+    command.x = static_cast<int>(std::lround(destination.x));
+    command.y = static_cast<int>(std::lround(destination.y));
+    command.width = static_cast<int>(std::lround(destination.x + destination.width)) - command.x;
+    command.height = static_cast<int>(std::lround(destination.y + destination.height)) - command.y;
+    command.flipX = flipX;
+    command.flipY = flipY;
+    command.color = Color32(tint).rgba;
+
+    if (command.width > 0 && command.height > 0 && command.sourceWidth > 0 && command.sourceHeight > 0) {
+        Record(command);
+    }
+}
+
+void SoftwareRenderer::DrawLayer(const SoftwareTexture &layer, const Rect &area) {
+    Command command {};
+    command.type = CommandType::texture;
+    command.texture = &layer;
+    command.x = command.sourceX = static_cast<int>(std::lround(area.x));
+    command.y = command.sourceY = static_cast<int>(std::lround(area.y));
+    command.width = command.sourceWidth = static_cast<int>(std::lround(area.x + area.width)) - command.x;
+    command.height = command.sourceHeight = static_cast<int>(std::lround(area.y + area.height)) - command.y;
+    command.color = 0xFFFFFFFF;
+    command.premultiplied = true;
+
+    if (command.width > 0 && command.height > 0) Record(command);
+}
+
+void SoftwareRenderer::DrawSprite(const Sprite &sprite, const SoftwareTexture &texture, const Rect &destination,
+                                  const AtlasRegion *region, bool flipX, bool flipY) {
+    Rect source {0, 0, static_cast<double>(texture.width), static_cast<double>(texture.height)};
+    if (region == nullptr) region = sprite.Region();
+    if (region != nullptr) {
+        source = {region->u0 * texture.width, region->v0 * texture.height,
+                  static_cast<double>(region->width), static_cast<double>(region->height)};
+    }
+
+    DrawTexture(texture, source, destination, sprite.FlipX() != flipX, sprite.FlipY() != flipY,
+                sprite.SpriteColor());
+}
+
+void SoftwareRenderer::DrawMask(const std::uint8_t *mask, int maskWidth, int maskHeight, int x, int y,
+                                const Color &color, int stride) {
+    Command command {};
+    command.type = CommandType::mask;
+    command.mask = mask;
+    command.x = x;
+    command.y = y;
+    command.width = maskWidth;
+    command.height = maskHeight;
+    command.stride = stride > 0 ? stride : maskWidth;
+    command.color = Color32(color).rgba;
+
+    if (maskWidth > 0 && maskHeight > 0) Record(command);
+}
+
+void SoftwareRenderer::DrawText(const TextLayout &layout, double x, double y, const Color &color) {
+    if (layout.atlas == nullptr || layout.Stale()) return;
+
+    const std::uint8_t *pixels = layout.atlas->Pixels().data();
+    const int stride = layout.atlas->Width();
+    for (const GlyphQuad &quad : layout.quads) {
+        DrawMask(pixels + static_cast<std::size_t>(quad.atlasY) * stride + quad.atlasX, quad.width, quad.height,
+                 static_cast<int>(std::lround(x + quad.x)), static_cast<int>(std::lround(y + quad.y)), color, stride);
+    }
+}
+
+void SoftwareRenderer::DrawLine(const Point &start, const Point &end, const Color &color) {
+    Command command {};
+    command.type = CommandType::line;
+    command.start = start;
+    command.end = end;
+    command.color = Color32(color).rgba;
+    Record(command);
+}
+
+void SoftwareRenderer::Flush() {
+    std::atomic<int> nextTile {0};
+    const int tileCount = tilesX * tilesY;
+
+    auto work = [&] {
+        std::vector<std::uint32_t> row(static_cast<std::size_t>(tileSize));
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++) RenderTile(tile, row);
+    };
+
+    // One part per thread, each taking tiles until none are left.
+    JobSystem &jobs = JobSystem::Shared();
+    const std::size_t parts = std::min({threads, jobs.Threads(), static_cast<unsigned int>(tileCount)});
+    jobs.ParallelFor(parts, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t part = first; part < last; ++part) work();
+    });
+
+    commands.clear();
+}
+
+void SoftwareRenderer::Record(Command &command) {
+    command.clip = clip;
+    commands.push_back(command);
+}
+
+void SoftwareRenderer::RenderTile(int index, std::vector<std::uint32_t> &row) {
+    const int x0 = index % tilesX * tileSize;
+    const int y0 = index / tilesX * tileSize;
+
+    for (const Command &command: commands) {
+        const Tile tile {std::max(x0, command.clip.x0), std::max(y0, command.clip.y0),
+                         std::min({x0 + tileSize, width, command.clip.x1}),
+                         std::min({y0 + tileSize, height, command.clip.y1})};
+        if (tile.x0 >= tile.x1 || tile.y0 >= tile.y1) continue;
+
+        if (command.type == CommandType::line) {
+            RenderLine(command, tile);
+            continue;
+        }
+
+        if (command.x >= tile.x1 || command.y >= tile.y1 || command.x + command.width <= tile.x0 ||
+            command.y + command.height <= tile.y0) {
+            continue;
+        }
+
+        if (command.type == CommandType::fill) {
+            RenderFill(command, tile);
+        } else if (command.type == CommandType::texture) {
+            RenderTexture(command, tile, row);
+        } else {
+            RenderMask(command, tile, row);
+        }
+    }
+}
+
+void SoftwareRenderer::RenderFill(const Command &command, const Tile &tile) {
+    const int left = std::max(command.x, tile.x0);
+    const int right = std::min(command.x + command.width, tile.x1);
+    const int top = std::max(command.y, tile.y0);
+    const int bottom = std::min(command.y + command.height, tile.y1);
+
+    for (int y = top; y < bottom; ++y) {
+        std::uint32_t *destination = pixels.data() + static_cast<std::size_t>(y) * width;
+        std::fill(destination + left, destination + right, command.color);
+    }
+}
+
+void SoftwareRenderer::RenderTexture(const Command &command, const Tile &tile, std::vector<std::uint32_t> &row) {
+    const int left = std::max(command.x, tile.x0);
+    const int right = std::min(command.x + command.width, tile.x1);
+    const int top = std::max(command.y, tile.y0);
+    const int bottom = std::min(command.y + command.height, tile.y1);
+    const SoftwareTexture &texture = *command.texture;
+
+    for (int y = top; y < bottom; ++y) {
+        int v = static_cast<int>((y - command.y + 0.5) * command.sourceHeight / command.height);
+        if (command.flipY) v = command.sourceHeight - 1 - v;
+        const int sourceY = std::min(std::max(command.sourceY + v, 0), texture.height - 1);
+        const std::uint32_t *sourceRow = texture.pixels.data() + static_cast<std::size_t>(sourceY) * texture.width;
+
+        // Gather the sampled texels into a row so blending runs over contiguous pixels.
+        for (int x = left; x < right; ++x) {
+            int u = static_cast<int>((x - command.x + 0.5) * command.sourceWidth / command.width);
+            if (command.flipX) u = command.sourceWidth - 1 - u;
+            row[x - left] = sourceRow[std::min(std::max(command.sourceX + u, 0), texture.width - 1)];
+        }
+
+        BlendRow(pixels.data() + static_cast<std::size_t>(y) * width + left, row.data(),
+                 static_cast<std::size_t>(right - left), command.color, command.premultiplied);
+    }
+}
+
+void SoftwareRenderer::RenderMask(const Command &command, const Tile &tile, std::vector<std::uint32_t> &row) {
+    const int left = std::max(command.x, tile.x0);
+    const int right = std::min(command.x + command.width, tile.x1);
+    const int top = std::max(command.y, tile.y0);
+    const int bottom = std::min(command.y + command.height, tile.y1);
+    const std::uint32_t color = command.color & 0xFFFFFF;
+    // The coverage becomes the source alpha; the color's own alpha is applied as tint.
+    const std::uint32_t tint = 0xFFFFFF | (command.color & 0xFF000000);
+
+    for (int y = top; y < bottom; ++y) {
+        const std::uint8_t *coverage = command.mask + static_cast<std::size_t>(y - command.y) * command.stride;
+        for (int x = left; x < right; ++x) {
+            row[x - left] = color | static_cast<std::uint32_t>(coverage[x - command.x]) << 24;
+        }
+
+        BlendRow(pixels.data() + static_cast<std::size_t>(y) * width + left, row.data(),
+                 static_cast<std::size_t>(right - left), tint, false);
+    }
+}
+
+void SoftwareRenderer::RenderLine(const Command &command, const Tile &tile) {
+    int x = static_cast<int>(std::lround(command.start.x));
+    int y = static_cast<int>(std::lround(command.start.y));
+    const int endX = static_cast<int>(std::lround(command.end.x));
+    const int endY = static_cast<int>(std::lround(command.end.y));
+
+    if (std::max(x, endX) < tile.x0 || std::min(x, endX) >= tile.x1 ||
+        std::max(y, endY) < tile.y0 || std::min(y, endY) >= tile.y1) {
+        return;
+    }
+
+    // Bresenham; every tile walks the whole line but only plots its own pixels.
+    const int dx = std::abs(endX - x);
+    const int dy = -std::abs(endY - y);
+    const int stepX = x < endX ? 1 : -1;
+    const int stepY = y < endY ? 1 : -1;
+    int error = dx + dy;
+
+    while (true) {
+        if (x >= tile.x0 && x < tile.x1 && y >= tile.y0 && y < tile.y1) {
+            std::uint32_t &pixel = pixels[static_cast<std::size_t>(y) * width + x];
+            pixel = BlendPixel(pixel, command.color, 0xFFFFFFFF, false);
+        }
+        if (x == endX && y == endY) break;
+
+        const int doubled = 2 * error;
+        if (doubled >= dy) {
+            error += dy;
+            x += stepX;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            y += stepY;
+        }
+    }
+}
+
+void SoftwareRenderer::WritePpm(const std::string &path) const {
+    std::ofstream out {path, std::ios::binary};
+    if (!out) throw std::runtime_error("Cannot write '" + path + "'");
+
+    out << "P6\n" << width << ' ' << height << "\n255\n";
+    for (std::uint32_t pixel: pixels) {
+        const char rgb[3] = {static_cast<char>(pixel & 0xFF), static_cast<char>(pixel >> 8 & 0xFF),
+                             static_cast<char>(pixel >> 16 & 0xFF)};
+        out.write(rgb, 3);
+    }
+}
+
+void SoftwareRenderer::WritePng(const std::string &path) const {
+    WriteRgbaPng(path, width, height, pixels);
+}
+
+void spic::WritePng(const std::string &path, const SoftwareTexture &image) {
+    WriteRgbaPng(path, image.width, image.height, image.pixels);
+}
@@ -0,0 +1,224 @@
+#ifndef SOFTWARERENDERER_H_
+#define SOFTWARERENDERER_H_
+
+#include "Color.hpp"
+#include "Point.hpp"
+#include "Rect.hpp"
+#include "Sprite.hpp"
+#include "TextLayout.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief An image in memory. Pixels are stored in the Color32 layout, row by row from the top.
+     */
+    struct SoftwareTexture {
+        int width;
+        int height;
+        std::vector<std::uint32_t> pixels;
+    };
+
+    /**
+     * @brief Write an image as an uncompressed RGBA PNG image.
+     * @exception A std::runtime_error is thrown when the file cannot be written.
+     */
+    void WritePng(const std::string &path, const SoftwareTexture &image);
+
+    /**
+     * @brief A render backend that draws into a framebuffer in memory instead of on a GPU.
+     * @details Meant for CI and simulation machines without a GPU, where Scene::RenderScene
+     *          still has to be benchmarked and checked against golden images. Draw calls are
+     *          recorded and only rasterized by Flush, which splits the framebuffer into square
+     *          tiles and lets the threads of JobSystem::Shared() render them; every tile applies
+     *          the draws in the recorded order, so the result does not depend on the number of
+     *          threads. Blending uses AVX2 or SSE2 kernels when the compiler targets them.
+     */
+    class SoftwareRenderer {
+    public:
+        /**
+         * @brief Constructor.
+         * @param width The width of the framebuffer in pixels.
+         * @param height The height of the framebuffer in pixels.
+         * @param threads The most threads of JobSystem::Shared() rendering tiles during Flush, at
+         *        least 1.
+         * @param tileSize The width and height of a tile in pixels.
+         */
+        SoftwareRenderer(int width, int height, unsigned int threads = 1, int tileSize = 64);
+
+        /**
+         * @brief Fill the whole framebuffer with a color, dropping all unflushed draws.
+         */
+        void Clear(const Color &color);
+
+        /**
+         * @brief Restrict the draws recorded from now on to a rectangle of the framebuffer.
+         * @param area The rectangle in framebuffer pixels, rounded outwards to whole pixels.
+         */
+        void Clip(const Rect &area);
+
+        /**
+         * @brief Let the draws recorded from now on cover the whole framebuffer again.
+         */
+        void ClearClip();
+
+        /**
+         * @brief Overwrite a rectangle with a color, without blending.
+         */
+        void Fill(const Rect &area, const Color &color);
+
+        /**
+         * @brief Draw part of a texture, scaled to a rectangle, with nearest-neighbour sampling
+         *        and alpha blending.
+         * @param texture The image to draw from. Must stay alive until Flush.
+         * @param source The part of the texture to draw, in texture pixels.
+         * @param destination Where to draw, in framebuffer pixels.
+         * @param flipX Mirror the image horizontally.
+         * @param flipY Mirror the image vertically.
+         * @param tint Every texel is multiplied by this color, alpha included.
+         */
+        void DrawTexture(const SoftwareTexture &texture, const Rect &source, const Rect &destination,
+                         bool flipX, bool flipY, const Color &tint);
+
+        /**
+         * @brief Draw a sprite with its flip and color settings.
+         * @param sprite The sprite.
+         * @param texture The sprite's image, or the texture region or Sprite::Region() refers to.
+         * @param destination Where to draw, in framebuffer pixels.
+         * @param region The part of the texture to draw, such as Animator::CurrentRegion(), or
+         *        nullptr to use the sprite's own Region(); as SpriteInstance::region.
+         * @param flipX Extra mirroring, such as an Animator's, on top of the sprite's own FlipX.
+         * @param flipY Extra mirroring on top of the sprite's own FlipY.
+         */
+        void DrawSprite(const Sprite &sprite, const SoftwareTexture &texture, const Rect &destination,
+                        const AtlasRegion *region = nullptr, bool flipX = false, bool flipY = false);
+
+        /**
+         * @brief Blend a rectangle of a framebuffer-sized image with premultiplied alpha, such as
+         *        a cached UILayer, onto the same rectangle of the framebuffer.
+         * @param layer The image, as large as the framebuffer. Must stay alive until Flush.
+         * @param area The rectangle to copy, in pixels.
+         */
+        void DrawLayer(const SoftwareTexture &layer, const Rect &area);
+
+        /**
+         * @brief Draw a coverage mask, such as a rasterized glyph, in a solid color.
+         * @param mask One byte of coverage per pixel, 255 is fully covered. Must stay alive until Flush.
+         * @param width The width of the mask in pixels.
+         * @param height The height of the mask in pixels.
+         * @param x The framebuffer column of the mask's left edge.
+         * @param y The framebuffer row of the mask's top edge.
+         * @param color The color of covered pixels.
+         * @param stride The distance between rows of the mask in bytes; 0 means width.
+         */
+        void DrawMask(const std::uint8_t *mask, int width, int height, int x, int y, const Color &color,
+                      int stride = 0);
+
+        /**
+         * @brief Draw a laid out text as one batch of glyph quads from its atlas.
+         * @details The atlas must not gain glyphs between this call and Flush, since that may
+         *          move its pixels. Stale layouts, whose atlas GlyphAtlas::Clear dropped, are
+         *          skipped.
+         * @param layout The text, from TextLayoutCache.
+         * @param x The framebuffer column of the text box's left edge.
+         * @param y The framebuffer row of the text box's top edge.
+         * @param color The color of the text.
+         */
+        void DrawText(const TextLayout &layout, double x, double y, const Color &color);
+
+        /**
+         * @brief Draw a one pixel wide line, as used by Debug::DrawLine.
+         */
+        void DrawLine(const Point &start, const Point &end, const Color &color);
+
+        /**
+         * @brief Rasterize all draws recorded since the last Flush or Clear.
+         */
+        void Flush();
+
+        [[nodiscard]] int Width() const { return width; }
+
+        [[nodiscard]] int Height() const { return height; }
+
+        /**
+         * @brief The framebuffer, in the same layout as SoftwareTexture::pixels.
+         */
+        [[nodiscard]] const std::vector<std::uint32_t> &Pixels() const { return pixels; }
+
+        /**
+         * @brief Write the framebuffer as a binary PPM image. Alpha is dropped.
+         * @exception A std::runtime_error is thrown when the file cannot be written.
+         */
+        void WritePpm(const std::string &path) const;
+
+        /**
+         * @brief Write the framebuffer as an uncompressed RGBA PNG image.
+         * @exception A std::runtime_error is thrown when the file cannot be written.
+         */
+        void WritePng(const std::string &path) const;
+
+    private:
+        enum class CommandType {
+            fill,
+            texture,
+            mask,
+            line
+        };
+
+        /**
+         * @brief The pixel bounds of a tile, right and bottom exclusive.
+         */
+        struct Tile {
+            int x0, y0, x1, y1;
+        };
+
+        /**
+         * @brief A recorded draw; which fields are used depends on type.
+         */
+        struct Command {
+            CommandType type;
+            const SoftwareTexture *texture;
+            const std::uint8_t *mask;
+            int sourceX, sourceY, sourceWidth, sourceHeight;
+            int x, y, width, height;
+            int stride;
+            bool flipX, flipY;
+            bool premultiplied;
+            std::uint32_t color;
+            Point start, end;
+
+            /**
+             * @brief The part of the framebuffer the draw may touch, in the same form as a tile.
+             */
+            Tile clip;
+        };
+
+        void Record(Command &command);
+
+        void RenderTile(int tile, std::vector<std::uint32_t> &row);
+
+        void RenderFill(const Command &command, const Tile &tile);
+
+        void RenderTexture(const Command &command, const Tile &tile, std::vector<std::uint32_t> &row);
+
+        void RenderMask(const Command &command, const Tile &tile, std::vector<std::uint32_t> &row);
+
+        void RenderLine(const Command &command, const Tile &tile);
+
+        int width;
+        int height;
+        unsigned int threads;
+        int tileSize;
+        int tilesX;
+        int tilesY;
+        Tile clip;
+        std::vector<std::uint32_t> pixels;
+        std::vector<Command> commands;
+    };
+
+}
+
+#endif // SOFTWARERENDERER_H_
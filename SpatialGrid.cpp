@@ -0,0 +1,96 @@
+#include "SpatialGrid.hpp"
+
+using namespace spic;
+
+SpatialGrid::SpatialGrid(double cellSize)
+    : cellSize {cellSize}, size {0},
+      minCellX {std::numeric_limits<int>::max()}, minCellY {std::numeric_limits<int>::max()},
+      maxCellX {std::numeric_limits<int>::min()}, maxCellY {std::numeric_limits<int>::min()} {}
+
+int SpatialGrid::Insert(const Rect &bounds) {
+    int id;
+    if (freeIds.empty()) {
+        id = static_cast<int>(entries.size());
+        entries.emplace_back();
+    } else {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+
+    entries[id].bounds = bounds;
+    entries[id].used = true;
+    Link(id);
+    ++size;
+
+    return id;
+}
+
+void SpatialGrid::Update(int id, const Rect &bounds) {
+    Entry &entry = entries[id];
+    entry.bounds = bounds;
+
+    if (CellOf(bounds.x) == entry.minX && CellOf(bounds.y) == entry.minY &&
+        CellOf(bounds.x + bounds.width) == entry.maxX && CellOf(bounds.y + bounds.height) == entry.maxY) {
+        return;
+    }
+
+    Unlink(id);
+    Link(id);
+}
+
+void SpatialGrid::Remove(int id) {
+    if (!Contains(id)) return;
+
+    Unlink(id);
+    entries[id].used = false;
+    freeIds.push_back(id);
+    --size;
+}
+
+void SpatialGrid::Clear() {
+    entries.clear();
+    freeIds.clear();
+    cells.clear();
+    size = 0;
+    minCellX = minCellY = std::numeric_limits<int>::max();
+    maxCellX = maxCellY = std::numeric_limits<int>::min();
+}
+
+bool SpatialGrid::Contains(int id) const {
+    return id >= 0 && static_cast<std::size_t>(id) < entries.size() && entries[id].used;
+}
+
+void SpatialGrid::Link(int id) {
+    Entry &entry = entries[id];
+    entry.minX = CellOf(entry.bounds.x);
+    entry.minY = CellOf(entry.bounds.y);
+    entry.maxX = CellOf(entry.bounds.x + entry.bounds.width);
+    entry.maxY = CellOf(entry.bounds.y + entry.bounds.height);
+
+    for (int cy = entry.minY; cy <= entry.maxY; ++cy) {
+        for (int cx = entry.minX; cx <= entry.maxX; ++cx) {
+            cells[Key(cx, cy)].push_back(id);
+        }
+    }
+
+    minCellX = std::min(minCellX, entry.minX);
+    minCellY = std::min(minCellY, entry.minY);
+    maxCellX = std::max(maxCellX, entry.maxX);
+    maxCellY = std::max(maxCellY, entry.maxY);
+}
+
+void SpatialGrid::Unlink(int id) {
+    const Entry &entry = entries[id];
+
+    for (int cy = entry.minY; cy <= entry.maxY; ++cy) {
+        for (int cx = entry.minX; cx <= entry.maxX; ++cx) {
+            std::vector<int> &cell = cells[Key(cx, cy)];
+            auto found = std::find(cell.begin(), cell.end(), id);
+            if (found != cell.end()) {
+                // Order within a cell does not matter, so swap-and-pop.
+                *found = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
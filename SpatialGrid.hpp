@@ -0,0 +1,234 @@
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#include "Rect.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief A uniform hash grid over axis-aligned rectangles, used as the acceleration
+     *        structure for spatial queries.
+     * @details Every entry is stored in each cell its bounds touch. The queries report an entry
+     *          only once without keeping any per-query state in the grid, so any number of
+     *          threads may query the same grid concurrently as long as nobody modifies it.
+     */
+    class SpatialGrid {
+    public:
+        /**
+         * @brief Constructor.
+         * @param cellSize The width and height of one cell in world units. A good value is
+         *        about twice the size of a typical entry.
+         */
+        explicit SpatialGrid(double cellSize);
+
+        /**
+         * @brief Add an entry to the grid.
+         * @param bounds The world-space bounds of the entry.
+         * @return The id of the new entry, used for all further calls.
+         */
+        int Insert(const Rect &bounds);
+
+        /**
+         * @brief Move or resize an entry. Cheap when the entry stays within the same cells.
+         * @param id The entry to update.
+         * @param bounds The new world-space bounds.
+         */
+        void Update(int id, const Rect &bounds);
+
+        /**
+         * @brief Remove an entry. Its id may be handed out again by a later Insert.
+         * @param id The entry to remove.
+         */
+        void Remove(int id);
+
+        /**
+         * @brief Remove all entries.
+         */
+        void Clear();
+
+        /**
+         * @brief Whether id refers to a live entry.
+         */
+        [[nodiscard]] bool Contains(int id) const;
+
+        /**
+         * @brief The bounds an entry was last inserted or updated with.
+         */
+        [[nodiscard]] const Rect &Bounds(int id) const { return entries[id].bounds; }
+
+        /**
+         * @brief The number of live entries.
+         */
+        [[nodiscard]] std::size_t Size() const { return size; }
+
+        [[nodiscard]] double CellSize() const { return cellSize; }
+
+        /**
+         * @brief Visit every entry whose bounds overlap area, each exactly once.
+         * @param area The region to search.
+         * @param visit Callable as visit(int id).
+         */
+        template<class F>
+        void Query(const Rect &area, F &&visit) const {
+            if (size == 0) return;
+
+            const int minX = std::max(CellOf(area.x), minCellX);
+            const int minY = std::max(CellOf(area.y), minCellY);
+            const int maxX = std::min(CellOf(area.x + area.width), maxCellX);
+            const int maxY = std::min(CellOf(area.y + area.height), maxCellY);
+
+            for (int cy = minY; cy <= maxY; ++cy) {
+                for (int cx = minX; cx <= maxX; ++cx) {
+                    const std::vector<int> *cell = Cell(cx, cy);
+                    if (cell == nullptr) continue;
+
+                    for (int id: *cell) {
+                        const Entry &entry = entries[id];
+                        // Report an entry only from the first cell it shares with the query.
+                        if (cx != std::max(entry.minX, minX) || cy != std::max(entry.minY, minY)) continue;
+                        if (entry.bounds.Overlaps(area)) visit(id);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Walk the cells crossed by a ray, nearest cell first.
+         * @details An entry spanning several cells is offered once per cell. Callers dedupe by only
+         *          accepting a hit whose distance lies in [enter, exit) of the cell it was found in.
+         * @param origin The start of the ray.
+         * @param direction The direction of the ray, normalized.
+         * @param maxDistance How far along the ray to walk.
+         * @param visit Callable as visit(const std::vector<int> &ids, double enter, double exit),
+         *        returning false to stop the walk.
+         */
+        template<class F>
+        void Traverse(const Point &origin, const Point &direction, double maxDistance, F &&visit) const {
+            if (size == 0) return;
+
+            int cx = CellOf(origin.x);
+            int cy = CellOf(origin.y);
+            const int stepX = direction.x > 0 ? 1 : (direction.x < 0 ? -1 : 0);
+            const int stepY = direction.y > 0 ? 1 : (direction.y < 0 ? -1 : 0);
+            const double inf = std::numeric_limits<double>::infinity();
+            const double deltaX = stepX != 0 ? cellSize / std::abs(direction.x) : inf;
+            const double deltaY = stepY != 0 ? cellSize / std::abs(direction.y) : inf;
+            double nextX = stepX > 0 ? ((cx + 1) * cellSize - origin.x) / direction.x
+                                     : (stepX < 0 ? (cx * cellSize - origin.x) / direction.x : inf);
+            double nextY = stepY > 0 ? ((cy + 1) * cellSize - origin.y) / direction.y
+                                     : (stepY < 0 ? (cy * cellSize - origin.y) / direction.y : inf);
+            double enter = 0;
+
+            while (!MovingAway(cx, cy, stepX, stepY)) {
+                const double exit = std::min(nextX, nextY);
+                const bool last = exit > maxDistance;
+                const std::vector<int> *cell = Cell(cx, cy);
+
+                if (cell != nullptr && !visit(*cell, enter, last ? inf : exit)) return;
+                if (last) return;
+
+                if (nextX < nextY) {
+                    cx += stepX;
+                    nextX += deltaX;
+                } else {
+                    cy += stepY;
+                    nextY += deltaY;
+                }
+                enter = exit;
+            }
+        }
+
+        /**
+         * @brief Visit entries in square rings of cells around a point, nearest ring first.
+         * @details Before each ring, keepGoing(lowerBound) is asked whether to continue; lowerBound
+         *          is a distance no entry in that ring or beyond can be closer than. Every entry is
+         *          visited once.
+         * @param point The point to search around.
+         * @param visit Callable as visit(int id).
+         * @param keepGoing Callable as keepGoing(double lowerBound), returning false to stop.
+         */
+        template<class F, class G>
+        void VisitRings(const Point &point, F &&visit, G &&keepGoing) const {
+            if (size == 0) return;
+
+            const int px = CellOf(point.x);
+            const int py = CellOf(point.y);
+            const int maxRing = std::max(std::max(px - minCellX, maxCellX - px),
+                                         std::max(py - minCellY, maxCellY - py));
+
+            for (int ring = 0; ring <= maxRing; ++ring) {
+                if (!keepGoing(ring == 0 ? 0.0 : (ring - 1) * cellSize)) return;
+
+                for (int cy = py - ring; cy <= py + ring; ++cy) {
+                    const bool edgeRow = cy == py - ring || cy == py + ring;
+                    for (int cx = px - ring; cx <= px + ring; cx += edgeRow || ring == 0 ? 1 : 2 * ring) {
+                        const std::vector<int> *cell = Cell(cx, cy);
+                        if (cell == nullptr) continue;
+
+                        for (int id: *cell) {
+                            // Report an entry only from the cell holding its point closest to the query.
+                            const Entry &entry = entries[id];
+                            const int ownerX = std::min(std::max(px, entry.minX), entry.maxX);
+                            const int ownerY = std::min(std::max(py, entry.minY), entry.maxY);
+                            if (ownerX == cx && ownerY == cy) visit(id);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        struct Entry {
+            Rect bounds;
+            int minX, minY, maxX, maxY;
+            bool used;
+        };
+
+        [[nodiscard]] int CellOf(double coordinate) const {
+            return static_cast<int>(std::floor(coordinate / cellSize));
+        }
+
+        static std::int64_t Key(int cx, int cy) {
+            return (static_cast<std::int64_t>(cx) << 32) | static_cast<std::uint32_t>(cy);
+        }
+
+        [[nodiscard]] const std::vector<int> *Cell(int cx, int cy) const {
+            auto found = cells.find(Key(cx, cy));
+            return found == cells.end() || found->second.empty() ? nullptr : &found->second;
+        }
+
+        /**
+         * @brief Whether a walk in the given direction can no longer reach an occupied cell.
+         */
+        [[nodiscard]] bool MovingAway(int cx, int cy, int stepX, int stepY) const {
+            return (cx > maxCellX && stepX >= 0) || (cx < minCellX && stepX <= 0) ||
+                   (cy > maxCellY && stepY >= 0) || (cy < minCellY && stepY <= 0);
+        }
+
+        void Link(int id);
+
+        void Unlink(int id);
+
+        double cellSize;
+        std::size_t size;
+        std::vector<Entry> entries;
+        std::vector<int> freeIds;
+        std::unordered_map<std::int64_t, std::vector<int>> cells;
+
+        /**
+         * @brief Conservative extent of all cells that were ever occupied, used to end
+         *        traversals that would otherwise walk empty space forever.
+         */
+        int minCellX, minCellY, maxCellX, maxCellY;
+    };
+
+}
+
+#endif // SPATIALGRID_H_
@@ -3,6 +3,8 @@
 
 #include "Component.hpp"
 #include "Color.hpp"
+#include "TextureAtlas.hpp"
+#include <cstdint>
 #include <string>
 #include <o_real_physics/physics_vector.hpp>
 
@@ -15,11 +17,18 @@ namespace spic {
     class Sprite : public Component {
     private:
         std::string sprite;
-        Color color;
+        Color32 color;
         bool flipX;
         bool flipY;
         int sortingLayer;
         int orderInLayer;
+
+        /**
+         * @brief The cached TextureAtlas::Find result, valid while regionGeneration equals
+         *        TextureAtlas::Generation(); SpriteSrc sets regionGeneration to 0.
+         */
+        mutable const AtlasRegion *region {nullptr};
+        mutable std::uint64_t regionGeneration {0};
     public:
         void SortingLayer(int newSortingLayer);
 
@@ -41,10 +50,33 @@ namespace spic {
 
         Color SpriteColor() const;
 
+        /**
+         * @brief Set the path of the sprite's image.
+         * @details Images are loaded through the ResourceCache, so sprites with the same path
+         *          share one texture.
+         * @param newSprite The path to a locally stored image file.
+         */
         void SpriteSrc(const std::string &newSprite);
 
         std::string SpriteSrc() const;
 
+        /**
+         * @brief The atlas region holding this sprite's image.
+         * @details Resolved through TextureAtlas::Find on first use, and again only after the
+         *          source changes or a table is loaded or cleared, so drawing does not look the
+         *          path up every frame. Filling the cache writes to the sprite, so the first call
+         *          after such a change must not race with other calls; once filled, calls only
+         *          read and may run on several threads.
+         * @return The region, or nullptr if the image is not in an atlas and is drawn from its own file.
+         */
+        const AtlasRegion *Region() const {
+            if (regionGeneration != TextureAtlas::Generation()) {
+                region = TextureAtlas::Find(sprite);
+                regionGeneration = TextureAtlas::Generation();
+            }
+            return region;
+        }
+
         Sprite(std::string sprite, Color color, bool flipX, bool flipY, int sortingLayer, int orderInLayer);
     };
 }
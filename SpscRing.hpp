@@ -0,0 +1,128 @@
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace spic {
+
+    /**
+     * @brief A bounded lock-free queue for exactly one producer thread and one consumer thread.
+     * @details Push and Pop never block and never allocate, which makes the queue safe to use
+     *          from real-time threads such as the audio mixer. The read and write positions live
+     *          on separate cache lines, and each side caches the other's position so it only
+     *          touches the shared one when the queue looks full or empty.
+     */
+    template<class T>
+    class SpscRing {
+    public:
+        /**
+         * @brief Constructor.
+         * @param capacity The minimum number of elements the queue can hold; rounded up to a
+         *        power of two.
+         */
+        explicit SpscRing(std::size_t capacity) {
+            std::size_t size = 2;
+            while (size < capacity) size *= 2;
+            mask = size - 1;
+            slots = std::make_unique<T[]>(size);
+        }
+
+        SpscRing(const SpscRing &other) = delete;
+
+        SpscRing &operator=(const SpscRing &other) = delete;
+
+        /**
+         * @brief Add an element. Only call from the producer thread.
+         * @return false if the queue is full; the element is not added then.
+         */
+        bool Push(T value) {
+            const std::size_t write = writeIndex.load(std::memory_order_relaxed);
+            if (write - cachedRead > mask) {
+                cachedRead = readIndex.load(std::memory_order_acquire);
+                if (write - cachedRead > mask) return false;
+            }
+
+            slots[write & mask] = std::move(value);
+            writeIndex.store(write + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Take the oldest element. Only call from the consumer thread.
+         * @return false if the queue is empty.
+         */
+        bool Pop(T &value) {
+            const std::size_t read = readIndex.load(std::memory_order_relaxed);
+            if (read == cachedWrite) {
+                cachedWrite = writeIndex.load(std::memory_order_acquire);
+                if (read == cachedWrite) return false;
+            }
+
+            value = std::move(slots[read & mask]);
+            readIndex.store(read + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Add as many of a run of elements as fit. Only call from the producer thread.
+         * @return The number of elements added, from the start of the run.
+         */
+        std::size_t Push(const T *values, std::size_t count) {
+            const std::size_t write = writeIndex.load(std::memory_order_relaxed);
+            if (write - cachedRead + count > mask + 1) cachedRead = readIndex.load(std::memory_order_acquire);
+
+            count = std::min(count, mask + 1 - (write - cachedRead));
+            for (std::size_t i = 0; i < count; ++i) slots[(write + i) & mask] = values[i];
+            writeIndex.store(write + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Take up to count of the oldest elements. Only call from the consumer thread.
+         * @return The number of elements taken.
+         */
+        std::size_t Pop(T *values, std::size_t count) {
+            const std::size_t read = readIndex.load(std::memory_order_relaxed);
+            if (cachedWrite - read < count) cachedWrite = writeIndex.load(std::memory_order_acquire);
+
+            count = std::min(count, cachedWrite - read);
+            for (std::size_t i = 0; i < count; ++i) values[i] = std::move(slots[(read + i) & mask]);
+            readIndex.store(read + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief The number of elements in the queue; only a snapshot when the other thread is active.
+         */
+        [[nodiscard]] std::size_t Size() const {
+            return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] std::size_t Capacity() const { return mask + 1; }
+
+    private:
+        static constexpr std::size_t cacheLine = 64;
+
+        std::unique_ptr<T[]> slots;
+        std::size_t mask;
+
+        /**
+         * @brief Written by the producer: its position, and its copy of the consumer's.
+         */
+        alignas(cacheLine) std::atomic<std::size_t> writeIndex {0};
+        std::size_t cachedRead {0};
+
+        /**
+         * @brief Written by the consumer: its position, and its copy of the producer's.
+         */
+        alignas(cacheLine) std::atomic<std::size_t> readIndex {0};
+        std::size_t cachedWrite {0};
+    };
+
+}
+
+#endif // SPSCRING_H_
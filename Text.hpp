@@ -3,6 +3,7 @@
 
 #include "UIObject.hpp"
 #include "Color.hpp"
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -18,6 +19,8 @@ namespace spic {
         right
     };
 
+    struct TextLayout;
+
     /**
      * @brief Class representing a piece of text which can be rendered.
      * @spicapi
@@ -28,7 +31,12 @@ namespace spic {
         std::string font;
         int size;
         Alignment alignment;
-        Color color;
+        Color32 color;
+
+        /**
+         * @brief The layout last computed for this text; see TextLayoutCache.
+         */
+        mutable std::shared_ptr<const TextLayout> layout;
     public:
         explicit Text(std::string font, std::string text,
                       const std::vector<std::shared_ptr<Component>> &components = {},
@@ -36,14 +44,28 @@ namespace spic {
                       Alignment alignment = Alignment::left, const Color &color = Color::black(), bool active = true,
                       int layer = 1, int size = 3, double width = 60, double height = 15);
 
+        /**
+         * @brief Set the string to display.
+         * @details Like the Font, Size and AlignmentValue setters, this drops the cached layout
+         *          when the value changes, and marks the text dirty in its Canvas().
+         */
         void TextString(const std::string &newText);
 
         [[nodiscard]] const std::string &TextString() const;
 
+        /**
+         * @brief Set the path of the font file.
+         * @details Fonts are loaded through the ResourceCache, so texts with the same font share it.
+         *          Drops the cached layout when the font changes.
+         * @param newFont The path to a locally stored font file.
+         */
         void Font(const std::string &newFont);
 
         [[nodiscard]] const std::string &Font() const;
 
+        /**
+         * @brief Set the font size. Drops the cached layout when the size changes.
+         */
         void Size(int newSize);
 
         [[nodiscard]] int Size() const;
@@ -52,9 +74,23 @@ namespace spic {
 
         [[nodiscard]] const spic::Alignment &AlignmentValue() const;
 
+        /**
+         * @brief Set the color of the text. Marks the text dirty in its Canvas().
+         */
         void ColorValue(const spic::Color &newColor);
 
-        [[nodiscard]] const spic::Color &ColorValue() const;
+        [[nodiscard]] spic::Color ColorValue() const;
+
+        /**
+         * @brief The layout last computed for this text, or nullptr after it changed. Check
+         *        TextLayout::Stale before using it; TextLayoutCache::Get does.
+         */
+        [[nodiscard]] const std::shared_ptr<const TextLayout> &CachedLayout() const { return layout; }
+
+        /**
+         * @brief Store a layout for this text; called by TextLayoutCache.
+         */
+        void CachedLayout(std::shared_ptr<const TextLayout> newLayout) const { layout = std::move(newLayout); }
     };
 
 }
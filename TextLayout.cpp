@@ -0,0 +1,170 @@
+#include "TextLayout.hpp"
+#include <algorithm>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief Decode UTF-8, replacing malformed sequences with U+FFFD.
+     */
+    std::u32string Decode(const std::string &string) {
+        std::u32string codepoints;
+        codepoints.reserve(string.size());
+
+        for (std::size_t i = 0; i < string.size();) {
+            const auto lead = static_cast<unsigned char>(string[i]);
+            const int length = lead < 0x80 ? 1 : lead >> 5 == 0x6 ? 2 : lead >> 4 == 0xE ? 3 : lead >> 3 == 0x1E ? 4 : 0;
+            if (length == 0 || i + length > string.size()) {
+                codepoints.push_back(0xFFFD);
+                ++i;
+                continue;
+            }
+
+            char32_t codepoint = length == 1 ? lead : lead & (0x7F >> length);
+            for (int k = 1; k < length; ++k) codepoint = codepoint << 6 | (static_cast<unsigned char>(string[i + k]) & 0x3F);
+            codepoints.push_back(codepoint);
+            i += length;
+        }
+
+        return codepoints;
+    }
+
+    /**
+     * @brief Everything a layout depends on, as a single string.
+     */
+    std::string KeyOf(const std::string &string, const std::string &font, int size, Alignment alignment,
+                      double boxWidth, double boxHeight) {
+        std::string key;
+        key.reserve(string.size() + font.size() + 48);
+        key.append(font).push_back('\0');
+        key.append(std::to_string(size)).push_back('\0');
+        key.append(std::to_string(static_cast<int>(alignment))).push_back('\0');
+        key.append(std::to_string(boxWidth)).push_back('\0');
+        key.append(std::to_string(boxHeight)).push_back('\0');
+        key.append(string);
+        return key;
+    }
+
+}
+
+TextLayoutCache::TextLayoutCache(std::size_t capacity) : capacity {capacity} {}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::Get(const Text &text) {
+    const std::shared_ptr<const TextLayout> &cached = text.CachedLayout();
+    if (cached != nullptr && cached->boxWidth == text.Width() && cached->boxHeight == text.Height() &&
+        !cached->Stale()) {
+        ++hits;
+        return cached;
+    }
+
+    std::shared_ptr<const TextLayout> layout = Get(text.TextString(), text.Font(), text.Size(),
+                                                   text.AlignmentValue(), text.Width(), text.Height());
+    text.CachedLayout(layout);
+    return layout;
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::Get(const std::string &string, const std::string &font, int size,
+                                                       Alignment alignment, double boxWidth, double boxHeight) {
+    std::string key = KeyOf(string, font, size, alignment, boxWidth, boxHeight);
+
+    auto found = entries.find(key);
+    if (found != entries.end()) {
+        if (!found->second.layout->Stale()) {
+            ++hits;
+            recency.splice(recency.begin(), recency, found->second.recency);
+            return found->second.layout;
+        }
+        recency.erase(found->second.recency);
+        entries.erase(found);
+    }
+
+    ++misses;
+    auto layout = std::make_shared<const TextLayout>(Build(GlyphAtlas::Get(font, size), string, alignment,
+                                                           boxWidth, boxHeight));
+
+    recency.push_front(key);
+    entries.emplace(std::move(key), Entry {layout, recency.begin()});
+    while (entries.size() > capacity) {
+        entries.erase(recency.back());
+        recency.pop_back();
+    }
+
+    return layout;
+}
+
+void TextLayoutCache::Clear() {
+    entries.clear();
+    recency.clear();
+}
+
+TextLayout TextLayoutCache::Build(GlyphAtlas *atlas, const std::string &string, Alignment alignment,
+                                  double boxWidth, double boxHeight) {
+    TextLayout layout {atlas, {}, 0, boxWidth, boxHeight, GlyphAtlas::Generation()};
+    if (atlas == nullptr) return layout;
+
+    const std::u32string codepoints = Decode(string);
+    const int lineHeight = atlas->LineHeight();
+
+    // Split into lines first, each a range of code points, wrapping at the last space that fits.
+    std::vector<std::pair<std::size_t, std::size_t>> lines;
+    std::vector<double> lineWidths;
+    std::size_t lineStart = 0;
+    std::size_t lastSpace = std::u32string::npos;
+    double penX = 0;
+    double widthAtSpace = 0;
+
+    for (std::size_t i = 0; i <= codepoints.size(); ++i) {
+        if (i == codepoints.size() || codepoints[i] == U'\n') {
+            lines.emplace_back(lineStart, i);
+            lineWidths.push_back(penX);
+            lineStart = i + 1;
+            lastSpace = std::u32string::npos;
+            penX = 0;
+            continue;
+        }
+
+        const Glyph *glyph = atlas->Find(codepoints[i]);
+        const double advance = glyph ? glyph->advance : 0;
+
+        if (codepoints[i] == U' ') {
+            lastSpace = i;
+            widthAtSpace = penX;
+        } else if (boxWidth > 0 && penX + advance > boxWidth && lastSpace != std::u32string::npos) {
+            lines.emplace_back(lineStart, lastSpace);
+            lineWidths.push_back(widthAtSpace);
+            lineStart = lastSpace + 1;
+            lastSpace = std::u32string::npos;
+            // Measure the part of the word that moves to the next line.
+            penX = 0;
+            for (std::size_t k = lineStart; k < i; ++k) {
+                const Glyph *moved = atlas->Find(codepoints[k]);
+                penX += moved ? moved->advance : 0;
+            }
+        }
+        penX += advance;
+    }
+
+    for (std::size_t line = 0; line < lines.size(); ++line) {
+        const double top = static_cast<double>(line) * lineHeight;
+        if (boxHeight > 0 && top + lineHeight > boxHeight && line > 0) break;
+
+        const double slack = boxWidth > 0 ? boxWidth - lineWidths[line] : 0;
+        double x = alignment == Alignment::center ? slack / 2 : alignment == Alignment::right ? slack : 0;
+        const double baseline = top + atlas->Ascent();
+
+        for (std::size_t i = lines[line].first; i < lines[line].second; ++i) {
+            const Glyph *glyph = atlas->Find(codepoints[i]);
+            if (glyph == nullptr) continue;
+
+            if (glyph->width > 0 && glyph->height > 0) {
+                layout.quads.push_back({x + glyph->bearingX, baseline - glyph->bearingY, glyph->x, glyph->y,
+                                        glyph->width, glyph->height});
+            }
+            x += glyph->advance;
+        }
+        ++layout.lines;
+    }
+
+    return layout;
+}
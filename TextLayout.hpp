@@ -0,0 +1,121 @@
+#ifndef TEXTLAYOUT_H_
+#define TEXTLAYOUT_H_
+
+#include "GlyphAtlas.hpp"
+#include "Text.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief One glyph of a laid out text: where to draw it and which part of the atlas to use.
+     */
+    struct GlyphQuad {
+        /**
+         * @brief Top-left corner of the quad, relative to the top-left corner of the text box.
+         */
+        double x;
+        double y;
+
+        /**
+         * @brief The glyph's rectangle in the GlyphAtlas, in pixels.
+         */
+        int atlasX;
+        int atlasY;
+        int width;
+        int height;
+    };
+
+    /**
+     * @brief A text shaped and positioned in its box, ready to be drawn as quads from one atlas.
+     */
+    struct TextLayout {
+        /**
+         * @brief The atlas the quads refer to, or nullptr if the font could not be loaded.
+         */
+        GlyphAtlas *atlas;
+        std::vector<GlyphQuad> quads;
+        int lines;
+
+        /**
+         * @brief The box the text was laid out in.
+         */
+        double boxWidth;
+        double boxHeight;
+
+        /**
+         * @brief GlyphAtlas::Generation() when the layout was built. Once it differs, atlas may
+         *        have been destroyed and the layout must not be drawn.
+         */
+        std::uint64_t generation;
+
+        [[nodiscard]] bool Stale() const { return generation != GlyphAtlas::Generation(); }
+    };
+
+    /**
+     * @brief Caches text layouts, so unchanged texts are not shaped again every frame.
+     * @details Layouts are keyed on everything that affects them: the string, font, size,
+     *          alignment and box size. A Text keeps the layout it was last given (see
+     *          Text::CachedLayout) until one of its setters changes it, so the cache is only
+     *          consulted for texts that changed. Layouts made stale by GlyphAtlas::Clear are
+     *          built again. The least recently used layouts are dropped when the cache holds more
+     *          than its capacity.
+     */
+    class TextLayoutCache {
+    public:
+        explicit TextLayoutCache(std::size_t capacity = 512);
+
+        /**
+         * @brief The layout of a Text, taken from the Text itself when it did not change.
+         */
+        std::shared_ptr<const TextLayout> Get(const Text &text);
+
+        /**
+         * @brief The layout of a string in a box, laying it out on a cache miss.
+         * @param boxWidth Lines are wrapped at spaces to fit this width; 0 disables wrapping.
+         * @param boxHeight The height of the box; lines below it are left out.
+         */
+        std::shared_ptr<const TextLayout> Get(const std::string &string, const std::string &font, int size,
+                                              Alignment alignment, double boxWidth, double boxHeight);
+
+        /**
+         * @brief Drop all layouts.
+         */
+        void Clear();
+
+        [[nodiscard]] std::size_t Hits() const { return hits; }
+
+        [[nodiscard]] std::size_t Misses() const { return misses; }
+
+        /**
+         * @brief Lay out a string without caching.
+         */
+        static TextLayout Build(GlyphAtlas *atlas, const std::string &string, Alignment alignment,
+                                double boxWidth, double boxHeight);
+
+    private:
+        struct Entry {
+            std::shared_ptr<const TextLayout> layout;
+            std::list<std::string>::iterator recency;
+        };
+
+        std::size_t capacity;
+        std::size_t hits {0};
+        std::size_t misses {0};
+        std::unordered_map<std::string, Entry> entries;
+
+        /**
+         * @brief Keys of entries, most recently used at the front.
+         */
+        std::list<std::string> recency;
+    };
+
+}
+
+#endif // TEXTLAYOUT_H_
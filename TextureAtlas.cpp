@@ -0,0 +1,83 @@
+#include "TextureAtlas.hpp"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace spic;
+
+std::vector<std::string> TextureAtlas::pages;
+std::unordered_map<std::string, AtlasRegion> TextureAtlas::regions;
+std::uint64_t TextureAtlas::generation {1};
+
+namespace {
+
+    std::vector<std::string> SplitFields(const std::string &line) {
+        std::vector<std::string> fields;
+        std::istringstream stream {line};
+        std::string field;
+        while (std::getline(stream, field, '\t')) fields.push_back(field);
+        return fields;
+    }
+
+}
+
+void TextureAtlas::Load(const std::string &tablePath) {
+    std::ifstream in {tablePath};
+    if (!in) throw std::runtime_error("Cannot open atlas table '" + tablePath + "'");
+
+    // Page numbers in the table are local to it; they follow the pages of earlier tables.
+    // Parsed on the side, so a malformed table leaves the loaded ones as they were.
+    const std::size_t firstPage = pages.size();
+    std::vector<std::string> newPages;
+    std::vector<std::pair<int, int>> pageSizes;
+    std::unordered_map<std::string, AtlasRegion> newRegions;
+    std::string line;
+    std::size_t lineNumber = 0;
+
+    try {
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            if (line.empty()) continue;
+
+            const std::vector<std::string> fields = SplitFields(line);
+            if (fields[0] == "page" && fields.size() == 5) {
+                newPages.push_back(fields[2]);
+                pageSizes.emplace_back(std::stoi(fields[3]), std::stoi(fields[4]));
+            } else if (fields[0] == "sprite" && fields.size() == 7) {
+                const std::size_t page = std::stoul(fields[2]);
+                const double pageWidth = pageSizes.at(page).first;
+                const double pageHeight = pageSizes.at(page).second;
+                const int x = std::stoi(fields[3]);
+                const int y = std::stoi(fields[4]);
+                const int width = std::stoi(fields[5]);
+                const int height = std::stoi(fields[6]);
+
+                newRegions[fields[1]] = {firstPage + page, x / pageWidth, y / pageHeight, (x + width) / pageWidth,
+                                         (y + height) / pageHeight, width, height};
+            } else {
+                throw std::invalid_argument("unknown record");
+            }
+        }
+    } catch (const std::logic_error &) {
+        throw std::runtime_error("Malformed atlas table '" + tablePath + "' at line " + std::to_string(lineNumber));
+    }
+
+    pages.insert(pages.end(), newPages.begin(), newPages.end());
+    for (auto &[path, region]: newRegions) regions[path] = region;
+    ++generation;
+}
+
+void TextureAtlas::Clear() {
+    pages.clear();
+    regions.clear();
+    ++generation;
+}
+
+const AtlasRegion *TextureAtlas::Find(const std::string &spriteSrc) {
+    auto found = regions.find(spriteSrc);
+    return found == regions.end() ? nullptr : &found->second;
+}
+
+const std::string &TextureAtlas::PagePath(std::size_t page) {
+    return pages.at(page);
+}
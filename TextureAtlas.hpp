@@ -0,0 +1,84 @@
+#ifndef TEXTUREATLAS_H_
+#define TEXTUREATLAS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief The part of an atlas page holding one sprite image.
+     */
+    struct AtlasRegion {
+        /**
+         * @brief Index of the page, see TextureAtlas::PagePath.
+         */
+        std::size_t page;
+
+        /**
+         * @brief Texture coordinates of the region, 0 ≤ u, v ≤ 1.
+         */
+        double u0;
+        double v0;
+        double u1;
+        double v1;
+
+        /**
+         * @brief Size of the original image in pixels.
+         */
+        int width;
+        int height;
+    };
+
+    /**
+     * @brief Resolves sprite image paths to regions of the atlas pages made by AtlasPacker.
+     * @details With all sprites on a handful of pages, loading reads a few large files and
+     *          nearly every sprite can be drawn in the same batch as its neighbours. Paths not
+     *          found in any loaded table are drawn from their own file, as before.
+     */
+    class TextureAtlas {
+    public:
+        /**
+         * @brief Read a lookup table written by AtlasPacker::WriteTable and make its regions
+         *        available through Find. Several tables may be loaded; later ones win.
+         * @param tablePath Path to the lookup table.
+         * @exception A std::runtime_error is thrown when the table cannot be read or is malformed.
+         */
+        static void Load(const std::string &tablePath);
+
+        /**
+         * @brief Forget all loaded tables.
+         */
+        static void Clear();
+
+        /**
+         * @brief Find the atlas region of a sprite image.
+         * @param spriteSrc The path the Sprite refers to.
+         * @return The region, or nullptr if the image is not in an atlas. The pointer stays
+         *         valid while Generation does not change.
+         */
+        static const AtlasRegion *Find(const std::string &spriteSrc);
+
+        /**
+         * @brief A number that changes on every Load and Clear, so cached Find results can be
+         *        checked for staleness.
+         */
+        [[nodiscard]] static std::uint64_t Generation() { return generation; }
+
+        /**
+         * @brief The image file of an atlas page.
+         */
+        static const std::string &PagePath(std::size_t page);
+
+    private:
+        static std::vector<std::string> pages;
+        static std::unordered_map<std::string, AtlasRegion> regions;
+        static std::uint64_t generation;
+    };
+
+}
+
+#endif // TEXTUREATLAS_H_
@@ -1,14 +1,53 @@
 #include "Time.hpp"
+#include <chrono>
+#include <stdexcept>
 
 using namespace spic;
 
 double Time::timeScale {1.0f};
 double Time::deltaTime {1.0f / 60.0f};
+double Time::smoothDeltaTime {1.0f / 60.0f};
+double Time::fixedDeltaTime {1.0f / 60.0f};
+std::uint64_t Time::frameCount {0};
+bool Time::fixedUpdating {false};
+
+namespace {
+
+    /**
+     * @brief How much of each new delta time goes into the smoothed one.
+     */
+    constexpr double smoothing = 0.05;
+
+    std::chrono::steady_clock::time_point lastTick {std::chrono::steady_clock::now()};
+
+}
 
 double Time::DeltaTime() {
+    return fixedUpdating ? fixedDeltaTime : deltaTime * timeScale;
+}
+
+double Time::UnscaledDeltaTime() {
     return deltaTime;
 }
 
+double Time::SmoothDeltaTime() {
+    return smoothDeltaTime;
+}
+
+double Time::FixedDeltaTime() {
+    return fixedDeltaTime;
+}
+
+void Time::FixedDeltaTime(double newFixedDeltaTime) {
+    // Also catches NaN.
+    if (!(newFixedDeltaTime > 0)) throw std::invalid_argument("The fixed delta time must be greater than 0");
+    fixedDeltaTime = newFixedDeltaTime;
+}
+
+std::uint64_t Time::FrameCount() {
+    return frameCount;
+}
+
 double Time::TimeScale() {
     return timeScale;
 }
@@ -16,3 +55,16 @@ double Time::TimeScale() {
 void Time::TimeScale(double newTimeScale) {
     timeScale = newTimeScale;
 }
+
+void Time::Tick() {
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - lastTick).count();
+    lastTick = now;
+    Tick(elapsed);
+}
+
+void Time::Tick(double unscaledDeltaTime) {
+    deltaTime = unscaledDeltaTime;
+    smoothDeltaTime += (unscaledDeltaTime - smoothDeltaTime) * smoothing;
+    ++frameCount;
+}
@@ -1,19 +1,54 @@
 #ifndef TIME_H_
 #define TIME_H_
 
+#include <cstdint>
+
 namespace spic {
 
     /**
      * @brief Class representing game time.
+     * @details Tick measures each frame with a monotonic clock. Delta times exist scaled, for
+     *          gameplay, and unscaled, for UI and profiling. The scale also applies to
+     *          how many fixed steps a GameLoop runs.
      */
     class Time {
     public:
         /**
-         * @brief The interval in seconds from the last frame to the current one (Read Only)
+         * @brief The interval in seconds from the last frame to the current one, multiplied by
+         *        TimeScale (Read Only)
+         * @details Inside a GameLoop fixed update this is FixedDeltaTime instead, the game time
+         *          the step advances.
          * @spicapi
          */
         static double DeltaTime();
 
+        /**
+         * @brief The interval in seconds from the last frame to the current one, regardless of
+         *        TimeScale.
+         */
+        static double UnscaledDeltaTime();
+
+        /**
+         * @brief The unscaled delta time averaged over roughly the last 20 frames, for display.
+         */
+        static double SmoothDeltaTime();
+
+        /**
+         * @brief The game time one fixed update advances, in seconds.
+         */
+        static double FixedDeltaTime();
+
+        /**
+         * @brief Set the game time one fixed update advances, in seconds.
+         * @exception A std::invalid_argument is thrown when the step is not greater than 0.
+         */
+        static void FixedDeltaTime(double newFixedDeltaTime);
+
+        /**
+         * @brief The number of frames since the game started.
+         */
+        static std::uint64_t FrameCount();
+
         /**
          * @brief The scale at which time passes.
          * @return time scale value
@@ -28,9 +63,31 @@ namespace spic {
          */
         static void TimeScale(double newTimeScale);
 
+        /**
+         * @brief Start a new frame: measure the time since the last Tick, and count the frame.
+         *        Called by GameLoop once per frame.
+         */
+        static void Tick();
+
+        /**
+         * @brief Start a new frame with a given unscaled delta time instead of a measured one,
+         *        as done by an InputPlayer replaying a recording.
+         */
+        static void Tick(double unscaledDeltaTime);
+
     private:
+        friend class GameLoop;
+
         static double deltaTime;
         static double timeScale;
+        static double smoothDeltaTime;
+        static double fixedDeltaTime;
+        static std::uint64_t frameCount;
+
+        /**
+         * @brief Set by GameLoop while it runs a fixed update.
+         */
+        static bool fixedUpdating;
 
     };
 
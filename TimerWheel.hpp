@@ -0,0 +1,116 @@
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Timers ordered by due tick in a hierarchical timing wheel.
+     * @details Each level has 64 slots; a slot of level n spans 64^n ticks. A timer is placed in
+     *          the lowest level whose slot still tells it apart from the current tick, and is
+     *          moved one level down each time the wheel reaches its slot, so scheduling is O(1)
+     *          and advancing a tick only looks at the slots the tick reaches. Timers further away
+     *          than the top level covers wait in an overflow list.
+     */
+    template<class T>
+    class TimerWheel {
+    public:
+        /**
+         * @brief Add a timer.
+         * @param due The tick at which the timer expires; timers due now or earlier expire at
+         *        the next tick.
+         */
+        void Schedule(std::uint64_t due, T value) {
+            Place({std::max(due, now + 1), std::move(value)});
+            ++size;
+        }
+
+        /**
+         * @brief Move the wheel forward and hand every timer that expired on the way to expired.
+         * @param to The new current tick.
+         * @param expired Called as expired(T&&) in order of due tick. Must not call Schedule or
+         *        Advance.
+         */
+        template<class F>
+        void Advance(std::uint64_t to, F &&expired) {
+            if (size == 0) {
+                now = std::max(now, to);
+                return;
+            }
+
+            while (now < to && size > 0) {
+                ++now;
+                Cascade();
+
+                std::vector<Timer> &slot = levels[0][now & mask];
+                for (Timer &timer: slot) expired(std::move(timer.value));
+                size -= slot.size();
+                slot.clear();
+            }
+            now = std::max(now, to);
+        }
+
+        [[nodiscard]] std::uint64_t Now() const { return now; }
+
+        /**
+         * @brief The number of timers that have not expired yet.
+         */
+        [[nodiscard]] std::size_t Size() const { return size; }
+
+    private:
+        struct Timer {
+            std::uint64_t due;
+            T value;
+        };
+
+        static constexpr unsigned int slotBits = 6;
+        static constexpr std::uint64_t mask = (1u << slotBits) - 1;
+        static constexpr unsigned int levelCount = 4;
+
+        void Place(Timer timer) {
+            for (unsigned int level = 0; level < levelCount; ++level) {
+                const unsigned int shift = slotBits * (level + 1);
+                if ((timer.due >> shift) == (now >> shift)) {
+                    levels[level][(timer.due >> (shift - slotBits)) & mask].push_back(std::move(timer));
+                    return;
+                }
+            }
+            overflow.push_back(std::move(timer));
+        }
+
+        /**
+         * @brief Move the timers of the slots the current tick reaches down a level, top first.
+         */
+        void Cascade() {
+            if ((now & mask) != 0) return;
+
+            unsigned int top = 1;
+            while (top < levelCount && ((now >> (slotBits * top)) & mask) == 0) ++top;
+            if (top == levelCount) Redistribute(overflow);
+            for (unsigned int level = std::min(top, levelCount - 1); level >= 1; --level) {
+                Redistribute(levels[level][(now >> (slotBits * level)) & mask]);
+            }
+        }
+
+        void Redistribute(std::vector<Timer> &timers) {
+            scratch.swap(timers);
+            for (Timer &timer: scratch) Place(std::move(timer));
+            scratch.clear();
+        }
+
+        std::array<std::array<std::vector<Timer>, mask + 1>, levelCount> levels;
+        std::vector<Timer> overflow;
+        std::vector<Timer> scratch;
+        std::uint64_t now {0};
+        std::size_t size {0};
+    };
+
+}
+
+#endif // TIMERWHEEL_H_
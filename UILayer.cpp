@@ -0,0 +1,161 @@
+#include "UILayer.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief More dirty rectangles than this are replaced by their bounding box, since each one
+     *        repaints the objects overlapping it.
+     */
+    constexpr std::size_t maxDirtyRects = 16;
+
+    Rect Union(const Rect &a, const Rect &b) {
+        const double left = std::min(a.x, b.x);
+        const double top = std::min(a.y, b.y);
+        return {left, top, std::max(a.x + a.width, b.x + b.width) - left,
+                std::max(a.y + a.height, b.y + b.height) - top};
+    }
+
+}
+
+UILayer::UILayer(int width, int height, unsigned int threads, double cellSize)
+    : renderer {width, height, threads}, texture {width, height, {}}, grid {cellSize} {
+    texture.pixels.assign(static_cast<std::size_t>(width) * height, 0);
+}
+
+void UILayer::Add(UIObject &object, const Rect &bounds) {
+    const int id = grid.Insert(bounds);
+    if (static_cast<std::size_t>(id) >= objects.size()) {
+        objects.resize(id + 1);
+        order.resize(id + 1);
+    }
+    objects[id] = &object;
+    order[id] = nextOrder++;
+    ids[&object] = id;
+    object.Canvas(this);
+    Invalidate(bounds);
+}
+
+void UILayer::Move(const UIObject &object, const Rect &bounds) {
+    auto found = ids.find(&object);
+    if (found == ids.end()) return;
+
+    Invalidate(grid.Bounds(found->second));
+    grid.Update(found->second, bounds);
+    Invalidate(bounds);
+}
+
+void UILayer::Invalidate(const UIObject &object) {
+    auto found = ids.find(&object);
+    if (found != ids.end()) Invalidate(grid.Bounds(found->second));
+}
+
+void UILayer::Invalidate(const Rect &area) {
+    // Snap outwards to whole pixels and clip to the layer.
+    const double left = std::max(0.0, std::floor(area.x));
+    const double top = std::max(0.0, std::floor(area.y));
+    const double right = std::min<double>(texture.width, std::ceil(area.x + area.width));
+    const double bottom = std::min<double>(texture.height, std::ceil(area.y + area.height));
+    if (left >= right || top >= bottom) return;
+
+    // Absorb every rectangle the new one overlaps or touches; growing may reach further ones.
+    Rect merged {left, top, right - left, bottom - top};
+    for (bool grown = true; grown;) {
+        grown = false;
+        for (std::size_t i = 0; i < dirty.size(); ++i) {
+            if (!dirty[i].Overlaps(merged)) continue;
+            merged = Union(merged, dirty[i]);
+            dirty[i] = dirty.back();
+            dirty.pop_back();
+            grown = true;
+            --i;
+        }
+    }
+    dirty.push_back(merged);
+
+    if (dirty.size() > maxDirtyRects) {
+        Rect bounds = dirty.front();
+        for (const Rect &rect: dirty) bounds = Union(bounds, rect);
+        dirty.assign(1, bounds);
+    }
+}
+
+void UILayer::Remove(const UIObject &object) {
+    auto found = ids.find(&object);
+    if (found == ids.end()) return;
+
+    Invalidate(grid.Bounds(found->second));
+    objects[found->second]->Canvas(nullptr);
+    grid.Remove(found->second);
+    objects[found->second] = nullptr;
+    ids.erase(found);
+}
+
+Button *UILayer::HitTest(const Point &point) const {
+    int top = -1;
+    grid.Query(Rect {point.x, point.y, 0, 0}, [&](int id) {
+        if (top >= 0 && Below(id, top)) return;
+        auto *button = dynamic_cast<Button *>(objects[id]);
+        if (button != nullptr && button->Active() && button->IsInteractable()) top = id;
+    });
+    return top < 0 ? nullptr : static_cast<Button *>(objects[top]);
+}
+
+bool UILayer::Below(int a, int b) const {
+    const int layerA = objects[a]->Layer();
+    const int layerB = objects[b]->Layer();
+    return layerA != layerB ? layerA < layerB : order[a] < order[b];
+}
+
+const UILayerStats &UILayer::Render(const DrawFunction &draw) {
+    stats = {dirty.size(), 0, 0, texture.pixels.size()};
+    repainted.swap(dirty);
+    dirty.clear();
+    if (repainted.empty()) return stats;
+
+    std::vector<int> overlapping;
+    for (const Rect &rect: repainted) {
+        renderer.Clip(rect);
+        renderer.Fill(rect, Color {0, 0, 0, 0});
+
+        overlapping.clear();
+        grid.Query(rect, [&](int id) { overlapping.push_back(id); });
+        std::sort(overlapping.begin(), overlapping.end(), [this](int a, int b) { return Below(a, b); });
+
+        for (int id: overlapping) {
+            if (!objects[id]->Active()) continue;
+            draw(renderer, *objects[id], grid.Bounds(id));
+            ++stats.objectsDrawn;
+        }
+
+        stats.repaintedPixels += static_cast<std::size_t>(rect.width * rect.height);
+    }
+
+    renderer.ClearClip();
+    renderer.Flush();
+
+    // Only the repainted rows change, so only those are copied into the texture.
+    const std::vector<std::uint32_t> &pixels = renderer.Pixels();
+    for (const Rect &rect: repainted) {
+        const auto left = static_cast<std::size_t>(rect.x);
+        const auto width = static_cast<std::size_t>(rect.width);
+        for (auto y = static_cast<std::size_t>(rect.y); y < static_cast<std::size_t>(rect.y + rect.height); ++y) {
+            const std::size_t start = y * texture.width + left;
+            std::copy_n(pixels.begin() + start, width, texture.pixels.begin() + start);
+        }
+    }
+
+    return stats;
+}
+
+void UILayer::Composite(SoftwareRenderer &target, bool repaintedOnly) const {
+    if (!repaintedOnly) {
+        target.DrawLayer(texture, {0, 0, static_cast<double>(texture.width), static_cast<double>(texture.height)});
+        return;
+    }
+
+    for (const Rect &rect: repainted) target.DrawLayer(texture, rect);
+}
@@ -0,0 +1,177 @@
+#ifndef UILAYER_H_
+#define UILAYER_H_
+
+#include "Button.hpp"
+#include "Rect.hpp"
+#include "SoftwareRenderer.hpp"
+#include "SpatialGrid.hpp"
+#include "UIObject.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Counters describing one call to UILayer::Render.
+     */
+    struct UILayerStats {
+        /**
+         * @brief The number of rectangles that were repainted.
+         */
+        std::size_t dirtyRects;
+
+        /**
+         * @brief The number of times an object was drawn; an object overlapping several dirty
+         *        rectangles is drawn once per rectangle.
+         */
+        std::size_t objectsDrawn;
+
+        /**
+         * @brief The number of pixels that were repainted.
+         */
+        std::size_t repaintedPixels;
+
+        /**
+         * @brief The number of pixels in the layer, for comparing against a full repaint.
+         */
+        std::size_t layerPixels;
+    };
+
+    /**
+     * @brief A cached, screen-sized image of user interface objects, repainted only where
+     *        something changed.
+     * @details UI objects are mostly static between frames. A UILayer keeps their rendered
+     *          image and a list of dirty rectangles: registering, moving, removing or changing
+     *          an object marks its bounds dirty, and Render repaints only those rectangles,
+     *          drawing just the objects overlapping them. Nearby dirty rectangles are merged,
+     *          and when there are too many they are replaced by their bounding box. The layer
+     *          is kept with premultiplied alpha, ready to be composited over the scene.
+     *          The same spatial grid finds the Button under the mouse, see HitTest.
+     */
+    class UILayer {
+    public:
+        /**
+         * @brief Draws one object into the layer. The renderer is already clipped to the
+         *        rectangle being repainted; the callback records draws but must not Flush.
+         */
+        using DrawFunction = std::function<void(SoftwareRenderer &renderer, UIObject &object, const Rect &bounds)>;
+
+        /**
+         * @brief Constructor.
+         * @param width The width of the layer in pixels.
+         * @param height The height of the layer in pixels.
+         * @param threads The number of threads rasterizing repainted rectangles.
+         * @param cellSize The cell size of the spatial grid over the objects, in pixels.
+         */
+        UILayer(int width, int height, unsigned int threads = 1, double cellSize = 128);
+
+        /**
+         * @brief Register a UI object and mark its bounds dirty. Sets the object's Canvas().
+         * @param object The object, which must stay alive until it is removed.
+         * @param bounds The screen-space bounds of everything the object draws.
+         */
+        void Add(UIObject &object, const Rect &bounds);
+
+        /**
+         * @brief Update the bounds of a registered object, marking both the old and the new
+         *        bounds dirty.
+         */
+        void Move(const UIObject &object, const Rect &bounds);
+
+        /**
+         * @brief Mark the bounds of a registered object dirty, after its contents changed.
+         */
+        void Invalidate(const UIObject &object);
+
+        /**
+         * @brief Mark a rectangle of the layer dirty.
+         */
+        void Invalidate(const Rect &area);
+
+        /**
+         * @brief Unregister an object and mark its bounds dirty.
+         */
+        void Remove(const UIObject &object);
+
+        /**
+         * @brief Whether anything has to be repainted.
+         */
+        [[nodiscard]] bool Dirty() const { return !dirty.empty(); }
+
+        /**
+         * @brief Whether an object is registered.
+         */
+        [[nodiscard]] bool Contains(const UIObject &object) const { return ids.count(&object) > 0; }
+
+        /**
+         * @brief The topmost active, interactable Button at a point, as drawn by Render.
+         * @details Only the objects in the grid cell of the point are tested, so the cost does
+         *          not grow with the number of objects in the layer. Other objects and buttons
+         *          that are not interactable let clicks through to what is below them.
+         * @return The button, or nullptr if there is none.
+         */
+        [[nodiscard]] Button *HitTest(const Point &point) const;
+
+        /**
+         * @brief Repaint the dirty rectangles, drawing the active objects overlapping them by
+         *        ascending GameObject::Layer(), and in the order they were added within a layer.
+         * @return Statistics for this call, also available through LastStats().
+         */
+        const UILayerStats &Render(const DrawFunction &draw);
+
+        /**
+         * @brief Blend the layer over a framebuffer of the same size.
+         * @param target The framebuffer; the layer must stay unchanged until its Flush.
+         * @param repaintedOnly Only blend the rectangles repainted by the last Render. This is
+         *        for targets that only redrew those rectangles as well, and still hold the
+         *        rest of the previous frame.
+         */
+        void Composite(SoftwareRenderer &target, bool repaintedOnly = false) const;
+
+        /**
+         * @brief The rectangles repainted by the last Render.
+         */
+        [[nodiscard]] const std::vector<Rect> &Repainted() const { return repainted; }
+
+        /**
+         * @brief The layer's image, with premultiplied alpha.
+         */
+        [[nodiscard]] const SoftwareTexture &Texture() const { return texture; }
+
+        /**
+         * @brief The statistics of the most recent Render, for per-frame reporting.
+         */
+        [[nodiscard]] const UILayerStats &LastStats() const { return stats; }
+
+    private:
+        /**
+         * @brief Whether the object with grid id a is drawn before the one with id b.
+         */
+        [[nodiscard]] bool Below(int a, int b) const;
+
+        SoftwareRenderer renderer;
+        SoftwareTexture texture;
+        SpatialGrid grid;
+        std::vector<UIObject *> objects;
+
+        /**
+         * @brief Per grid id: when the object was added, which is its drawing order.
+         */
+        std::vector<std::uint64_t> order;
+        std::uint64_t nextOrder {0};
+        std::unordered_map<const UIObject *, int> ids;
+
+        /**
+         * @brief Disjoint rectangles with whole-pixel edges, inside the layer.
+         */
+        std::vector<Rect> dirty;
+        std::vector<Rect> repainted;
+        UILayerStats stats {0, 0, 0, 0};
+    };
+
+}
+
+#endif // UILAYER_H_
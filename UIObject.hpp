@@ -5,27 +5,50 @@
 
 namespace spic {
 
+    class UILayer;
+
     /**
      * @brief Base class for a user interface object like Button or Text.
+     * @details When the object is registered with a UILayer, changes that alter how it looks
+     *          mark it dirty there, so the layer repaints only that part of the screen: resizing
+     *          calls Canvas()->Move with the new bounds, while changing its contents or
+     *          activating or deactivating it calls Canvas()->Invalidate(*this).
      * @spicapi
      */
     class UIObject : public GameObject {
     private:
         double width;
         double height;
+        UILayer *canvas {nullptr};
     public:
         explicit UIObject(const std::vector<std::shared_ptr<Component>> &components = {},
                           const std::string &parentName = "", const std::string &name = "", const std::string &tag = "",
                           bool active = true, int layer = 0, double newWidth = 0, double newHeight = 0,
                           bool autoInsert = false);
 
+        /**
+         * @brief Set the width. Marks the object dirty in its Canvas().
+         */
         void Width(double newWidth);
 
         [[nodiscard]] double Width() const;
 
+        /**
+         * @brief Set the height. Marks the object dirty in its Canvas().
+         */
         void Height(double newHeight);
 
         [[nodiscard]] double Height() const;
+
+        /**
+         * @brief The UILayer the object is drawn into, or nullptr if it is not in one.
+         */
+        [[nodiscard]] UILayer *Canvas() const { return canvas; }
+
+        /**
+         * @brief Set the UILayer the object is drawn into; called by UILayer.
+         */
+        void Canvas(UILayer *newCanvas) { canvas = newCanvas; }
     };
 
 }
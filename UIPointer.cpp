@@ -0,0 +1,38 @@
+#include "UIPointer.hpp"
+
+using namespace spic;
+
+UIPointer::UIPointer(UILayer &layer, InputDispatcher &dispatcher)
+    : layer {layer}, dispatcher {dispatcher}, moves {dispatcher.SubscribeMoves(*this)},
+      clicks {dispatcher.Subscribe(Input::MouseButton::LEFT, *this)} {}
+
+UIPointer::~UIPointer() {
+    dispatcher.Unsubscribe(moves);
+    dispatcher.Unsubscribe(clicks);
+}
+
+Button *UIPointer::Hovered() const {
+    // The button may have been removed from the layer since.
+    return hovered != nullptr && layer.Contains(*hovered) ? hovered : nullptr;
+}
+
+void UIPointer::Refresh() {
+    hovered = layer.HitTest(position);
+}
+
+void UIPointer::OnMouseMoved(const MouseEvent &event) {
+    position = event.position;
+    hovered = layer.HitTest(position);
+}
+
+void UIPointer::OnMouseClicked(const MouseEvent &event) {
+    position = event.position;
+    pressed = layer.HitTest(position);
+}
+
+void UIPointer::OnMouseReleased(const MouseEvent &event) {
+    position = event.position;
+    Button *released = layer.HitTest(position);
+    if (released != nullptr && released == pressed) released->Click();
+    pressed = nullptr;
+}
@@ -0,0 +1,75 @@
+#ifndef UIPOINTER_H_
+#define UIPOINTER_H_
+
+#include "Button.hpp"
+#include "IMouseListener.hpp"
+#include "InputDispatcher.hpp"
+#include "UILayer.hpp"
+
+namespace spic {
+
+    /**
+     * @brief Routes the mouse to the buttons of a UILayer: tracks which button is hovered, and
+     *        calls Button::Click when the left button is pressed and released on the same one.
+     * @details Only the mouse events of the frame are looked at, through an InputDispatcher,
+     *          and each one costs a single UILayer::HitTest.
+     */
+    class UIPointer : public IMouseListener {
+    public:
+        /**
+         * @brief Constructor, subscribing to mouse moves and the left button.
+         * @param layer The layer with the buttons. Must outlive the pointer.
+         * @param dispatcher The dispatcher to subscribe to. Must outlive the pointer.
+         */
+        UIPointer(UILayer &layer, InputDispatcher &dispatcher);
+
+        /**
+         * @brief Destructor, unsubscribing.
+         */
+        ~UIPointer();
+
+        UIPointer(const UIPointer &other) = delete;
+
+        UIPointer &operator=(const UIPointer &other) = delete;
+
+        /**
+         * @brief The button under the mouse since it last moved, or nullptr.
+         */
+        [[nodiscard]] Button *Hovered() const;
+
+        /**
+         * @brief Test again what is under the mouse, after buttons moved while it stood still.
+         */
+        void Refresh();
+
+        void OnMouseMoved() override {}
+
+        void OnMouseClicked() override {}
+
+        void OnMousePressed() override {}
+
+        void OnMouseReleased() override {}
+
+        void OnMouseMoved(const MouseEvent &event) override;
+
+        void OnMouseClicked(const MouseEvent &event) override;
+
+        void OnMouseReleased(const MouseEvent &event) override;
+
+    private:
+        UILayer &layer;
+        InputDispatcher &dispatcher;
+        InputDispatcher::Subscription moves;
+        InputDispatcher::Subscription clicks;
+        Point position {0, 0};
+        Button *hovered {nullptr};
+
+        /**
+         * @brief The button the left mouse button went down on.
+         */
+        Button *pressed {nullptr};
+    };
+
+}
+
+#endif // UIPOINTER_H_
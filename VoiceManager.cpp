@@ -0,0 +1,180 @@
+#include "VoiceManager.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace spic;
+
+VoiceManager::VoiceManager(AudioMixer &mixer, std::size_t maxVoices, float threshold)
+    : mixer {mixer}, maxVoices {maxVoices}, threshold {threshold} {}
+
+VoiceManager::~VoiceManager() {
+    for (Source source: active) Demote(sources[source]);
+    for (AudioMixer::Voice voice: stopping) mixer.Stop(voice);
+}
+
+VoiceManager::Source VoiceManager::Add() {
+    Source source;
+    if (freeSources.empty()) {
+        source = static_cast<Source>(sources.size());
+        sources.emplace_back();
+    } else {
+        source = freeSources.back();
+        freeSources.pop_back();
+    }
+
+    sources[source] = {nullptr, {0, 0}, 1, 0, false, false, 0, AudioMixer::noVoice, 0, 0, 0, 0, 0, false};
+    return source;
+}
+
+void VoiceManager::Remove(Source source) {
+    Stop(source);
+    sources[source].clip = nullptr;
+    freeSources.push_back(source);
+}
+
+void VoiceManager::Play(Source source, std::shared_ptr<const AudioSamples> clip, float volume, bool looping) {
+    SourceState &state = sources[source];
+    Detach(state);
+    state.clip = std::move(clip);
+    state.volume = volume;
+    state.looping = looping;
+    state.frame = 0;
+
+    // Nothing to play: a source that was playing its previous clip stops, as Update needs a length.
+    if (state.clip == nullptr || state.clip->Frames() == 0) {
+        if (state.playing) Deactivate(source);
+        return;
+    }
+
+    if (!state.playing) {
+        state.playing = true;
+        state.activeIndex = static_cast<std::uint32_t>(active.size());
+        active.push_back(source);
+    }
+}
+
+void VoiceManager::Stop(Source source) {
+    if (sources[source].playing) Deactivate(source);
+}
+
+void VoiceManager::Volume(Source source, float volume) {
+    sources[source].volume = volume;
+}
+
+void VoiceManager::Priority(Source source, int priority) {
+    sources[source].priority = priority;
+}
+
+void VoiceManager::Position(Source source, const Point &position) {
+    sources[source].position = position;
+}
+
+void VoiceManager::Listener(const Point &position) {
+    listener = position;
+}
+
+void VoiceManager::Distances(double newMinDistance, double newMaxDistance) {
+    minDistance = newMinDistance;
+    maxDistance = std::max(newMaxDistance, newMinDistance);
+}
+
+void VoiceManager::Update(double deltaTime) {
+    stopping.erase(std::remove_if(stopping.begin(), stopping.end(), [this](AudioMixer::Voice voice) {
+        return mixer.Stop(voice);
+    }), stopping.end());
+
+    // Advance every playing source, real or virtual, and drop the ones that ended.
+    for (std::size_t i = 0; i < active.size();) {
+        SourceState &state = sources[active[i]];
+        const auto length = static_cast<double>(state.clip->Frames());
+        state.frame += deltaTime * state.clip->sampleRate;
+
+        const bool mixerEnded = state.voice != AudioMixer::noVoice && !mixer.Playing(state.voice);
+        if (state.looping) {
+            state.frame = std::fmod(state.frame, length);
+        } else if (state.frame >= length || mixerEnded) {
+            Deactivate(active[i]);
+            continue;
+        }
+
+        const double dx = state.position.x - listener.x;
+        const double dy = state.position.y - listener.y;
+        const double distance = std::sqrt(dx * dx + dy * dy);
+        const double range = maxDistance - minDistance;
+        const double attenuation = distance <= minDistance ? 1
+                                 : range <= 0 ? 0
+                                 : std::max(0.0, 1 - (distance - minDistance) / range);
+        state.loudness = static_cast<float>(state.volume * attenuation);
+        state.pan = static_cast<float>(std::min(std::max(maxDistance > 0 ? dx / maxDistance : 0, -1.0), 1.0));
+        ++i;
+    }
+
+    // Rank the audible sources; only the first maxVoices get a real voice.
+    ranked.clear();
+    for (Source source: active) {
+        sources[source].wanted = false;
+        if (sources[source].loudness >= threshold) ranked.push_back(source);
+    }
+
+    if (ranked.size() > maxVoices) {
+        std::nth_element(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(maxVoices), ranked.end(),
+                         [this](Source a, Source b) {
+                             const SourceState &first = sources[a];
+                             const SourceState &second = sources[b];
+                             if (first.priority != second.priority) return first.priority > second.priority;
+                             if (first.loudness != second.loudness) return first.loudness > second.loudness;
+                             return a < b;
+                         });
+        ranked.resize(maxVoices);
+    }
+    for (Source source: ranked) sources[source].wanted = true;
+
+    // Demote before promoting, so the freed mixer voices can be reused right away. A source whose
+    // stop did not fit in the command queue keeps its voice and is demoted again next Update.
+    for (Source source: active) {
+        if (!sources[source].wanted) Demote(sources[source]);
+    }
+
+    for (Source source: ranked) {
+        SourceState &state = sources[source];
+        if (state.voice == AudioMixer::noVoice) {
+            state.voice = mixer.Play(state.clip, state.loudness, state.pan, state.looping,
+                                     static_cast<std::size_t>(state.frame));
+            state.sentVolume = state.loudness;
+            state.sentPan = state.pan;
+            if (state.voice != AudioMixer::noVoice) ++realCount;
+        } else {
+            if (state.loudness != state.sentVolume) mixer.Volume(state.voice, state.sentVolume = state.loudness);
+            if (state.pan != state.sentPan) mixer.Pan(state.voice, state.sentPan = state.pan);
+        }
+    }
+
+    mixer.Update();
+}
+
+void VoiceManager::Deactivate(Source source) {
+    SourceState &state = sources[source];
+    Detach(state);
+    state.playing = false;
+
+    // Move the last active source into the gap.
+    const Source last = active.back();
+    active[state.activeIndex] = last;
+    sources[last].activeIndex = state.activeIndex;
+    active.pop_back();
+}
+
+bool VoiceManager::Demote(SourceState &state) {
+    if (state.voice == AudioMixer::noVoice) return true;
+    if (!mixer.Stop(state.voice)) return false;
+    state.voice = AudioMixer::noVoice;
+    --realCount;
+    return true;
+}
+
+void VoiceManager::Detach(SourceState &state) {
+    if (Demote(state)) return;
+    stopping.push_back(state.voice);
+    state.voice = AudioMixer::noVoice;
+    --realCount;
+}
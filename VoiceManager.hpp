@@ -0,0 +1,202 @@
+#ifndef VOICEMANAGER_H_
+#define VOICEMANAGER_H_
+
+#include "AudioMixer.hpp"
+#include "Point.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace spic {
+
+    /**
+     * @brief Decides which of all playing sounds are actually mixed, so the cost of mixing stays
+     *        bounded however many sources play at once.
+     * @details Every source has a priority and a loudness, which is its volume attenuated by
+     *          its distance to the listener. Once per frame, Update ranks the playing sources by
+     *          priority and then loudness; at most maxVoices of them get a real AudioMixer voice.
+     *          The others, and all sources too quiet to hear, are virtual: their playback
+     *          position keeps advancing but nothing is mixed. A virtual source that climbs back
+     *          into the ranking resumes at the position it would have reached.
+     */
+    class VoiceManager {
+    public:
+        using Source = std::uint32_t;
+
+        /**
+         * @brief A handle that refers to no source, for sources not added yet.
+         */
+        static constexpr Source noSource = ~Source {0};
+
+        /**
+         * @brief Constructor.
+         * @param mixer The mixer playing the real voices. Must outlive the manager.
+         * @param maxVoices The highest number of real voices.
+         * @param threshold Sources with a loudness below this are always virtual.
+         */
+        explicit VoiceManager(AudioMixer &mixer, std::size_t maxVoices = 32, float threshold = 0.001f);
+
+        /**
+         * @brief Destructor, stopping all real voices.
+         */
+        ~VoiceManager();
+
+        VoiceManager(const VoiceManager &other) = delete;
+
+        VoiceManager &operator=(const VoiceManager &other) = delete;
+
+        /**
+         * @brief Add a stopped source.
+         * @return A handle for controlling the source.
+         */
+        Source Add();
+
+        /**
+         * @brief Stop and remove a source. Its handle may be handed out again by a later Add.
+         */
+        void Remove(Source source);
+
+        /**
+         * @brief Start playing a clip from its beginning; the source becomes real or virtual at
+         *        the next Update.
+         * @param source The source.
+         * @param clip The sound; a null or empty clip stops the source instead.
+         * @param volume The volume, 0 ≤ volume ≤ 1.
+         * @param looping Start over when the end is reached.
+         */
+        void Play(Source source, std::shared_ptr<const AudioSamples> clip, float volume, bool looping);
+
+        void Stop(Source source);
+
+        /**
+         * @brief Whether a source is playing, really or virtually.
+         */
+        [[nodiscard]] bool Playing(Source source) const { return sources[source].playing; }
+
+        /**
+         * @brief Whether a playing source is currently being mixed.
+         */
+        [[nodiscard]] bool Real(Source source) const { return sources[source].voice != AudioMixer::noVoice; }
+
+        void Volume(Source source, float volume);
+
+        [[nodiscard]] float Volume(Source source) const { return sources[source].volume; }
+
+        /**
+         * @brief Set the priority of a source; higher priorities are mixed first, whatever their loudness.
+         */
+        void Priority(Source source, int priority);
+
+        [[nodiscard]] int Priority(Source source) const { return sources[source].priority; }
+
+        /**
+         * @brief Set the position of a source in the world.
+         */
+        void Position(Source source, const Point &position);
+
+        [[nodiscard]] const Point &Position(Source source) const { return sources[source].position; }
+
+        /**
+         * @brief Set the position of the listener, usually the Camera.
+         */
+        void Listener(const Point &position);
+
+        /**
+         * @brief Set how loudness falls off with distance: full volume up to minDistance, then
+         *        linearly down to silence at maxDistance.
+         */
+        void Distances(double minDistance, double maxDistance);
+
+        /**
+         * @brief Advance all playing sources and reassign the real voices. Call once per frame
+         *        from the game thread; also calls AudioMixer::Update.
+         * @param deltaTime The time since the last Update, in seconds.
+         */
+        void Update(double deltaTime);
+
+        /**
+         * @brief The number of sources mixed after the last Update.
+         */
+        [[nodiscard]] std::size_t RealCount() const { return realCount; }
+
+        /**
+         * @brief The number of sources playing virtually after the last Update.
+         */
+        [[nodiscard]] std::size_t VirtualCount() const { return active.size() - realCount; }
+
+    private:
+        struct SourceState {
+            std::shared_ptr<const AudioSamples> clip;
+            Point position;
+            float volume;
+            int priority;
+            bool looping;
+            bool playing;
+
+            /**
+             * @brief The playback position in frames of the clip, tracked whether real or not.
+             */
+            double frame;
+
+            /**
+             * @brief The mixer voice while real, otherwise AudioMixer::noVoice.
+             */
+            AudioMixer::Voice voice;
+
+            /**
+             * @brief Computed by Update, and the values last sent to the mixer.
+             */
+            float loudness;
+            float pan;
+            float sentVolume;
+            float sentPan;
+
+            /**
+             * @brief Position in active while playing.
+             */
+            std::uint32_t activeIndex;
+            bool wanted;
+        };
+
+        void Deactivate(Source source);
+
+        /**
+         * @brief Stop the real voice of a source, if any.
+         * @return false if the mixer's command queue was full; the source keeps its voice then.
+         */
+        bool Demote(SourceState &state);
+
+        /**
+         * @brief Take the real voice away from a source, leaving it in stopping if it could not
+         *        be stopped yet.
+         */
+        void Detach(SourceState &state);
+
+        AudioMixer &mixer;
+        std::size_t maxVoices;
+        float threshold;
+        Point listener {0, 0};
+        double minDistance {0};
+        double maxDistance {1000};
+
+        std::vector<SourceState> sources;
+        std::vector<Source> freeSources;
+
+        /**
+         * @brief The playing sources, and scratch space for ranking them.
+         */
+        std::vector<Source> active;
+        std::vector<Source> ranked;
+        std::size_t realCount {0};
+
+        /**
+         * @brief Voices taken from their sources whose stop did not fit in the mixer's command
+         *        queue; tried again every Update.
+         */
+        std::vector<AudioMixer::Voice> stopping;
+    };
+
+}
+
+#endif // VOICEMANAGER_H_
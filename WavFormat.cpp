@@ -0,0 +1,102 @@
+#include "WavFormat.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace spic;
+
+namespace {
+
+    std::uint32_t Read32(const unsigned char *bytes) {
+        return bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    }
+
+    std::uint16_t Read16(const unsigned char *bytes) {
+        return static_cast<std::uint16_t>(bytes[0] | bytes[1] << 8);
+    }
+
+    constexpr std::uint16_t formatPcm = 1;
+    constexpr std::uint16_t formatFloat = 3;
+    constexpr std::uint16_t formatExtensible = 0xFFFE;
+
+}
+
+WavFormat WavFormat::Parse(const unsigned char *file, std::size_t size, const std::string &name) {
+    if (size < 12 || std::memcmp(file, "RIFF", 4) != 0 || std::memcmp(file + 8, "WAVE", 4) != 0) {
+        throw std::runtime_error("'" + name + "' is not a WAV file");
+    }
+
+    WavFormat format {};
+    bool haveFormat = false;
+    bool haveData = false;
+
+    for (std::size_t offset = 12; offset + 8 <= size && !haveData;) {
+        const unsigned char *chunk = file + offset;
+        const std::size_t chunkSize = Read32(chunk + 4);
+        const std::size_t body = offset + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && body + 16 <= size) {
+            std::uint16_t tag = Read16(file + body);
+            if (tag == formatExtensible && chunkSize >= 40 && body + 40 <= size) tag = Read16(file + body + 24);
+
+            format.channels = Read16(file + body + 2);
+            format.sampleRate = static_cast<int>(Read32(file + body + 4));
+            format.bitsPerSample = Read16(file + body + 14);
+            format.isFloat = tag == formatFloat;
+            if ((tag != formatPcm && tag != formatFloat) || (format.isFloat && format.bitsPerSample != 32)) {
+                throw std::runtime_error("'" + name + "' is compressed; only PCM and float WAV files are supported");
+            }
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            format.dataOffset = body;
+            format.dataBytes = std::min(chunkSize, size - body);
+            haveData = true;
+        }
+
+        // Chunks are padded to an even size.
+        offset = body + chunkSize + (chunkSize & 1);
+    }
+
+    if (!haveFormat || !haveData) throw std::runtime_error("'" + name + "' has no fmt or data chunk");
+    if (format.channels < 1 || format.channels > 2 || format.sampleRate <= 0 ||
+        (format.bitsPerSample != 8 && format.bitsPerSample != 16 && format.bitsPerSample != 24 &&
+         format.bitsPerSample != 32)) {
+        throw std::runtime_error("'" + name + "' has an unsupported sample format");
+    }
+
+    return format;
+}
+
+void WavFormat::Decode(const unsigned char *frames, std::size_t count, float *samples) const {
+    const std::size_t total = count * channels;
+
+    switch (bitsPerSample) {
+        case 8:
+            for (std::size_t i = 0; i < total; ++i) samples[i] = (frames[i] - 128) / 128.0f;
+            break;
+        case 16:
+            for (std::size_t i = 0; i < total; ++i) {
+                samples[i] = static_cast<std::int16_t>(Read16(frames + i * 2)) / 32768.0f;
+            }
+            break;
+        case 24:
+            for (std::size_t i = 0; i < total; ++i) {
+                const unsigned char *bytes = frames + i * 3;
+                // Place the 24 bits at the top of an int so the sign carries over.
+                const auto value = static_cast<std::int32_t>(static_cast<std::uint32_t>(bytes[0]) << 8 |
+                                                             static_cast<std::uint32_t>(bytes[1]) << 16 |
+                                                             static_cast<std::uint32_t>(bytes[2]) << 24);
+                samples[i] = static_cast<float>(value / 2147483648.0);
+            }
+            break;
+        default:
+            if (isFloat) {
+                std::memcpy(samples, frames, total * sizeof(float));
+            } else {
+                for (std::size_t i = 0; i < total; ++i) {
+                    samples[i] = static_cast<float>(static_cast<std::int32_t>(Read32(frames + i * 4)) / 2147483648.0);
+                }
+            }
+            break;
+    }
+}
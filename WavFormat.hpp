@@ -0,0 +1,52 @@
+#ifndef WAVFORMAT_H_
+#define WAVFORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace spic {
+
+    /**
+     * @brief The layout of the samples in a WAV file.
+     */
+    struct WavFormat {
+        int sampleRate;
+        int channels;
+
+        /**
+         * @brief 8, 16, 24 or 32; 32-bit samples are floats when isFloat is set.
+         */
+        int bitsPerSample;
+        bool isFloat;
+
+        /**
+         * @brief Where the samples start in the file, and their size in bytes.
+         */
+        std::size_t dataOffset;
+        std::size_t dataBytes;
+
+        [[nodiscard]] std::size_t FrameBytes() const { return static_cast<std::size_t>(channels) * bitsPerSample / 8; }
+
+        [[nodiscard]] std::size_t Frames() const { return dataBytes / FrameBytes(); }
+
+        /**
+         * @brief Read the header of a WAV file in memory.
+         * @param name The file's name, for error messages.
+         * @exception A std::runtime_error is thrown when the data is not a supported WAV file:
+         *            uncompressed PCM or float samples, one or two channels.
+         */
+        static WavFormat Parse(const unsigned char *file, std::size_t size, const std::string &name);
+
+        /**
+         * @brief Convert frames to float samples between -1 and 1, keeping the channels interleaved.
+         * @param frames The first frame to convert, inside the file's data.
+         * @param count The number of frames.
+         * @param samples Receives count × channels samples.
+         */
+        void Decode(const unsigned char *frames, std::size_t count, float *samples) const;
+    };
+
+}
+
+#endif // WAVFORMAT_H_
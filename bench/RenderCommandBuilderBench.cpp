@@ -0,0 +1,96 @@
+/**
+ * @file
+ * @brief Times RenderCommandBuilder::Build at 1 to N threads over the same queue, and checks that
+ *        every thread count produces exactly the output of the 1-thread build.
+ * @details Usage: RenderCommandBuilderBench [sprites = 20000] [max threads = hardware threads]
+ *          [repeats = 50]. Link against the engine. Build runs on JobSystem::Shared(), so thread
+ *          counts above its Threads() run as that many. Exits with 1 when an output differs.
+ */
+#include "../RenderCommandBuilder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace spic;
+
+namespace {
+
+    bool SameOutput(const std::vector<SpriteVertex> &vertices, const std::vector<RenderCommand> &commands,
+                    const std::vector<SpriteVertex> &expectedVertices,
+                    const std::vector<RenderCommand> &expectedCommands) {
+        if (vertices.size() != expectedVertices.size() || commands.size() != expectedCommands.size()) return false;
+        if (std::memcmp(vertices.data(), expectedVertices.data(), vertices.size() * sizeof(SpriteVertex)) != 0) {
+            return false;
+        }
+        for (std::size_t i = 0; i < commands.size(); ++i) {
+            const RenderCommand &a = commands[i];
+            const RenderCommand &b = expectedCommands[i];
+            if (a.texture != b.texture || a.material != b.material || a.firstVertex != b.firstVertex ||
+                a.vertexCount != b.vertexCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    const std::size_t spriteCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const unsigned int maxThreads = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10))
+                                             : std::max(std::thread::hardware_concurrency(), 1u);
+    const int repeats = argc > 3 ? std::atoi(argv[3]) : 50;
+
+    // A fixed seed, so runs are comparable: a few textures, some transparent and missing sprites.
+    std::mt19937 random {36};
+    const char *textures[] = {"a.png", "b.png", "c.png", "d.png"};
+    std::vector<std::unique_ptr<Sprite>> sprites;
+    std::vector<SpriteInstance> instances;
+    RenderQueue queue;
+    for (std::size_t i = 0; i < spriteCount; ++i) {
+        sprites.push_back(std::make_unique<Sprite>(textures[random() % 4], Color(1, 1, 1, random() % 10 ? 1 : 0),
+                                                   random() % 2 == 0, random() % 2 == 0,
+                                                   static_cast<int>(random() % 3), static_cast<int>(random() % 4)));
+        const Transform transform {{static_cast<double>(random() % 1000), static_cast<double>(random() % 1000)},
+                                   static_cast<double>(random() % 628) / 100, 1.5};
+        instances.push_back({random() % 50 ? sprites.back().get() : nullptr, transform, 32, 16, nullptr,
+                             false, false});
+        queue.Add(RenderQueue::KeyOf(*sprites.back()));
+    }
+    queue.Sort();
+
+    std::vector<SpriteVertex> expectedVertices;
+    std::vector<RenderCommand> expectedCommands;
+    double baseline = 0;
+    bool identical = true;
+
+    std::printf("%zu sprites, %d repeats\nthreads  us/build  speedup  output\n", spriteCount, repeats);
+    for (unsigned int threads = 1; threads <= maxThreads; ++threads) {
+        RenderCommandBuilder builder {threads};
+        std::vector<SpriteVertex> vertices;
+        std::vector<RenderCommand> commands;
+        builder.Build(queue, instances.data(), vertices, commands);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i) builder.Build(queue, instances.data(), vertices, commands);
+        const double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                              std::max(repeats, 1);
+
+        if (threads == 1) {
+            baseline = micros;
+            expectedVertices = vertices;
+            expectedCommands = commands;
+        }
+        const bool same = SameOutput(vertices, commands, expectedVertices, expectedCommands);
+        identical = identical && same;
+        std::printf("%7u  %8.1f  %7.2f  %s\n", threads, micros, baseline / micros, same ? "identical" : "DIFFERS");
+    }
+
+    return identical ? 0 : 1;
+}
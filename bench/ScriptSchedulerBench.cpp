@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @brief Times ScriptScheduler::Update against a plain virtual loop over the same scripts in
+ *        shuffled order, on the main thread, and then as one parallel batch at 1 to N threads.
+ * @details Usage: ScriptSchedulerBench [scripts = 50000] [max threads = hardware threads]
+ *          [repeats = 200]. Link against the engine. The scripts are spread over five types.
+ *          Every run must leave the scripts in the state the virtual loop left them in; exits
+ *          with 1 when one does not.
+ */
+#include "../ScriptScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief A script doing a little arithmetic on its own state, like moving an object.
+     */
+    class Counter : public BehaviourScript {
+    public:
+        std::uint32_t state {0};
+        bool parallel {false};
+
+        ScriptAccess Access() const override { return {{}, {}, parallel}; }
+    };
+
+    template<std::uint32_t N>
+    class Step final : public Counter {
+    public:
+        void OnUpdate() override { state = state * 1664525u + 1013904223u + N; }
+    };
+
+    /**
+     * @brief The average time of one call, in microseconds, after one call to warm up.
+     */
+    double Measure(int repeats, const std::function<void()> &update) {
+        update();
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeats; ++i) update();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+               std::max(repeats, 1);
+    }
+
+    std::uint64_t Checksum(const std::vector<Counter *> &scripts) {
+        std::uint64_t sum = 0;
+        for (const Counter *script: scripts) sum = sum * 31 + script->state;
+        return sum;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    const std::size_t scriptCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000;
+    const unsigned int maxThreads = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10))
+                                             : std::max(std::thread::hardware_concurrency(), 1u);
+    const int repeats = argc > 3 ? std::atoi(argv[3]) : 200;
+
+    // A fixed seed, so runs are comparable.
+    std::mt19937 random {49};
+    std::vector<std::unique_ptr<Counter>> owned;
+    std::vector<Counter *> scripts;
+    for (std::size_t i = 0; i < scriptCount; ++i) {
+        switch (random() % 5) {
+            case 0: owned.push_back(std::make_unique<Step<0>>()); break;
+            case 1: owned.push_back(std::make_unique<Step<1>>()); break;
+            case 2: owned.push_back(std::make_unique<Step<2>>()); break;
+            case 3: owned.push_back(std::make_unique<Step<3>>()); break;
+            default: owned.push_back(std::make_unique<Step<4>>()); break;
+        }
+        scripts.push_back(owned.back().get());
+    }
+
+    auto reset = [&](bool parallel) {
+        for (Counter *script: scripts) {
+            script->state = 0;
+            script->parallel = parallel;
+        }
+    };
+    auto add = [&](ScriptScheduler &scheduler) {
+        for (const std::unique_ptr<Counter> &script: owned) {
+            if (auto *step = dynamic_cast<Step<0> *>(script.get())) scheduler.Add(*step);
+            else if (auto *step = dynamic_cast<Step<1> *>(script.get())) scheduler.Add(*step);
+            else if (auto *step = dynamic_cast<Step<2> *>(script.get())) scheduler.Add(*step);
+            else if (auto *step = dynamic_cast<Step<3> *>(script.get())) scheduler.Add(*step);
+            else scheduler.Add(*static_cast<Step<4> *>(script.get()));
+        }
+    };
+
+    // The scripts are in no particular order in memory, as after a scene has been played a while.
+    std::vector<Counter *> shuffled = scripts;
+    std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+    std::printf("%zu scripts of 5 types, %d repeats\n", scriptCount, repeats);
+    reset(false);
+    const double virtualLoop = Measure(repeats, [&] {
+        for (Counter *script: shuffled) {
+            if (script->Active()) script->OnUpdate();
+        }
+    });
+    const std::uint64_t expected = Checksum(scripts);
+    std::printf("main thread, shuffled virtual loop  %9.1f us/update\n", virtualLoop);
+
+    bool identical = true;
+    reset(false);
+    {
+        JobSystem jobs {0};
+        ScriptScheduler scheduler {jobs};
+        add(scheduler);
+        const double grouped = Measure(repeats, [&] { scheduler.Update(); });
+        const bool same = Checksum(scripts) == expected;
+        identical = identical && same;
+        std::printf("main thread, ScriptScheduler        %9.1f us/update  %s\n", grouped,
+                    same ? "identical" : "DIFFERS");
+    }
+
+    std::printf("\none parallel batch\nthreads  us/update  speedup  state\n");
+    double baseline = 0;
+    for (unsigned int threads = 1; threads <= maxThreads; ++threads) {
+        reset(true);
+        JobSystem jobs {threads - 1};
+        ScriptScheduler scheduler {jobs};
+        add(scheduler);
+        const double micros = Measure(repeats, [&] { scheduler.Update(); });
+        if (threads == 1) baseline = micros;
+
+        const bool same = Checksum(scripts) == expected;
+        identical = identical && same;
+        std::printf("%7u  %9.1f  %7.2f  %s\n", threads, micros, baseline / micros, same ? "identical" : "DIFFERS");
+    }
+
+    return identical ? 0 : 1;
+}
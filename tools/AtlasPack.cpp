@@ -0,0 +1,373 @@
+/**
+ * @file
+ * @brief Packs sprite images into atlas pages at build time and writes the lookup table
+ *        TextureAtlas::Load reads.
+ * @details Usage: AtlasPack <output> <page width> <page height> [padding = 1] <image.png>...
+ *          Writes the pages as <output>-0.png, <output>-1.png, ... and the table as
+ *          <output>.atlas. Every image is listed under the path it was given as, which must be
+ *          the SpriteSrc of the sprites showing it. Reads non-interlaced 8-bit PNG images of
+ *          every color type. Link against the engine. Exits with 1 on an error.
+ */
+#include "../AtlasPacker.hpp"
+#include "../SoftwareRenderer.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace spic;
+
+namespace {
+
+    /**
+     * @brief Reads a deflate stream bit by bit, least significant bit first.
+     */
+    class BitReader {
+    public:
+        BitReader(const std::vector<unsigned char> &data, std::size_t position) : data {data}, position {position} {}
+
+        unsigned int Bits(int count) {
+            unsigned int value = 0;
+            for (int i = 0; i < count; ++i) {
+                if (bit == 0) {
+                    if (position >= data.size()) throw std::runtime_error("Truncated deflate stream");
+                    current = data[position++];
+                }
+                value |= ((current >> bit) & 1u) << i;
+                bit = (bit + 1) % 8;
+            }
+            return value;
+        }
+
+        /**
+         * @brief Skip to the next whole byte and take count bytes from there.
+         */
+        void Bytes(std::size_t count, std::vector<unsigned char> &out) {
+            bit = 0;
+            if (data.size() - position < count) throw std::runtime_error("Truncated deflate stream");
+            out.insert(out.end(), data.begin() + static_cast<std::ptrdiff_t>(position),
+                       data.begin() + static_cast<std::ptrdiff_t>(position + count));
+            position += count;
+        }
+
+    private:
+        const std::vector<unsigned char> &data;
+        std::size_t position;
+        unsigned int current {0};
+        int bit {0};
+    };
+
+    /**
+     * @brief A canonical Huffman code, as the number of codes of every length and the symbols
+     *        in code order.
+     */
+    struct Huffman {
+        std::array<int, 16> counts {};
+        std::vector<int> symbols;
+
+        explicit Huffman(const std::vector<int> &lengths) {
+            for (int length: lengths) ++counts[length];
+            counts[0] = 0;
+
+            std::array<int, 16> offsets {};
+            for (int length = 1; length < 16; ++length) offsets[length] = offsets[length - 1] + counts[length - 1];
+            symbols.resize(lengths.size());
+            for (std::size_t symbol = 0; symbol < lengths.size(); ++symbol) {
+                if (lengths[symbol] != 0) symbols[offsets[lengths[symbol]]++] = static_cast<int>(symbol);
+            }
+        }
+
+        int Decode(BitReader &in) const {
+            int code = 0;
+            int first = 0;
+            int index = 0;
+            for (int length = 1; length < 16; ++length) {
+                code |= static_cast<int>(in.Bits(1));
+                if (code - first < counts[length]) return symbols[index + code - first];
+                index += counts[length];
+                first = (first + counts[length]) << 1;
+                code <<= 1;
+            }
+            throw std::runtime_error("Invalid Huffman code in deflate stream");
+        }
+    };
+
+    constexpr int lengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    constexpr int lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                     3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    constexpr int distanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                      257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+                                      12289, 16385, 24577};
+    constexpr int distanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                       7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    void InflateBlock(BitReader &in, const Huffman &literals, const Huffman &distances,
+                      std::vector<unsigned char> &out) {
+        while (true) {
+            const int symbol = literals.Decode(in);
+            if (symbol < 256) {
+                out.push_back(static_cast<unsigned char>(symbol));
+                continue;
+            }
+            if (symbol == 256) return;
+            if (symbol > 285) throw std::runtime_error("Invalid length in deflate stream");
+
+            const int length = lengthBase[symbol - 257] + static_cast<int>(in.Bits(lengthExtra[symbol - 257]));
+            const int code = distances.Decode(in);
+            if (code > 29) throw std::runtime_error("Invalid distance in deflate stream");
+            const auto distance = static_cast<std::size_t>(distanceBase[code] +
+                                                           static_cast<int>(in.Bits(distanceExtra[code])));
+            if (distance > out.size()) throw std::runtime_error("Invalid distance in deflate stream");
+            for (int i = 0; i < length; ++i) out.push_back(out[out.size() - distance]);
+        }
+    }
+
+    /**
+     * @brief Decompress a zlib stream. The checksum is not verified.
+     */
+    std::vector<unsigned char> Inflate(const std::vector<unsigned char> &zlib) {
+        if (zlib.size() < 2 || (zlib[0] & 0x0F) != 8 || (zlib[1] & 0x20) != 0) {
+            throw std::runtime_error("Unsupported zlib stream");
+        }
+
+        BitReader in {zlib, 2};
+        std::vector<unsigned char> out;
+        bool last = false;
+        while (!last) {
+            last = in.Bits(1) != 0;
+            const unsigned int type = in.Bits(2);
+            if (type == 0) {
+                in.Bytes(4, out);
+                const unsigned int length = out[out.size() - 4] | out[out.size() - 3] << 8;
+                out.resize(out.size() - 4);
+                in.Bytes(length, out);
+            } else if (type == 1) {
+                std::vector<int> lengths(288, 8);
+                std::fill(lengths.begin() + 144, lengths.begin() + 256, 9);
+                std::fill(lengths.begin() + 256, lengths.begin() + 280, 7);
+                InflateBlock(in, Huffman {lengths}, Huffman {std::vector<int>(30, 5)}, out);
+            } else if (type == 2) {
+                const unsigned int literalCount = in.Bits(5) + 257;
+                const unsigned int distanceCount = in.Bits(5) + 1;
+                const unsigned int codeCount = in.Bits(4) + 4;
+
+                static constexpr int order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+                std::vector<int> codeLengths(19, 0);
+                for (unsigned int i = 0; i < codeCount; ++i) codeLengths[order[i]] = static_cast<int>(in.Bits(3));
+                const Huffman lengthCode {codeLengths};
+
+                std::vector<int> lengths;
+                while (lengths.size() < literalCount + distanceCount) {
+                    const int symbol = lengthCode.Decode(in);
+                    if (symbol < 16) {
+                        lengths.push_back(symbol);
+                        continue;
+                    }
+                    int repeat = 0;
+                    int value = 0;
+                    if (symbol == 16) {
+                        if (lengths.empty()) throw std::runtime_error("Invalid code lengths in deflate stream");
+                        value = lengths.back();
+                        repeat = 3 + static_cast<int>(in.Bits(2));
+                    } else if (symbol == 17) {
+                        repeat = 3 + static_cast<int>(in.Bits(3));
+                    } else {
+                        repeat = 11 + static_cast<int>(in.Bits(7));
+                    }
+                    lengths.insert(lengths.end(), static_cast<std::size_t>(repeat), value);
+                }
+                if (lengths.size() > literalCount + distanceCount) {
+                    throw std::runtime_error("Invalid code lengths in deflate stream");
+                }
+
+                const std::vector<int> literalLengths(lengths.begin(), lengths.begin() + literalCount);
+                const std::vector<int> distanceLengths(lengths.begin() + literalCount, lengths.end());
+                InflateBlock(in, Huffman {literalLengths}, Huffman {distanceLengths}, out);
+            } else {
+                throw std::runtime_error("Invalid deflate block type");
+            }
+        }
+        return out;
+    }
+
+    std::uint32_t BigEndian(const unsigned char *bytes) {
+        return static_cast<std::uint32_t>(bytes[0]) << 24 | bytes[1] << 16 | bytes[2] << 8 | bytes[3];
+    }
+
+    int Paeth(int a, int b, int c) {
+        const int p = a + b - c;
+        const int pa = std::abs(p - a);
+        const int pb = std::abs(p - b);
+        const int pc = std::abs(p - c);
+        return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+    }
+
+    /**
+     * @brief Read a PNG image into the Color32 layout.
+     * @exception A std::runtime_error is thrown when the file cannot be read, is malformed, or
+     *            uses a bit depth other than 8 or interlacing.
+     */
+    SoftwareTexture ReadPng(const std::string &path) {
+        std::ifstream file {path, std::ios::binary};
+        if (!file) throw std::runtime_error("Cannot read '" + path + "'");
+        const std::vector<unsigned char> bytes {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        if (bytes.size() < 8 || std::memcmp(bytes.data(), signature, 8) != 0) {
+            throw std::runtime_error("'" + path + "' is not a PNG image");
+        }
+
+        int width = 0;
+        int height = 0;
+        int colorType = -1;
+        std::vector<unsigned char> palette;
+        std::vector<unsigned char> paletteAlpha;
+        std::vector<unsigned char> compressed;
+        for (std::size_t position = 8; position + 12 <= bytes.size();) {
+            const std::uint32_t length = BigEndian(&bytes[position]);
+            if (bytes.size() - position - 12 < length) throw std::runtime_error("'" + path + "' is truncated");
+            const std::string type {reinterpret_cast<const char *>(&bytes[position + 4]), 4};
+            const unsigned char *data = &bytes[position + 8];
+
+            if (type == "IHDR" && length >= 13) {
+                width = static_cast<int>(BigEndian(data));
+                height = static_cast<int>(BigEndian(data + 4));
+                colorType = data[9];
+                if (data[8] != 8 || data[12] != 0) {
+                    throw std::runtime_error("'" + path + "' is not a non-interlaced 8-bit PNG image");
+                }
+            } else if (type == "PLTE") {
+                palette.assign(data, data + length);
+            } else if (type == "tRNS") {
+                paletteAlpha.assign(data, data + length);
+            } else if (type == "IDAT") {
+                compressed.insert(compressed.end(), data, data + length);
+            } else if (type == "IEND") {
+                break;
+            }
+            position += 12 + length;
+        }
+
+        static constexpr int channelsOf[7] = {1, 0, 3, 1, 2, 0, 4};
+        if (colorType < 0 || colorType > 6 || channelsOf[colorType] == 0 || width <= 0 || height <= 0) {
+            throw std::runtime_error("'" + path + "' has an unsupported color type");
+        }
+        const int channels = channelsOf[colorType];
+        const std::size_t stride = static_cast<std::size_t>(width) * channels;
+
+        std::vector<unsigned char> raw = Inflate(compressed);
+        if (raw.size() < (stride + 1) * height) throw std::runtime_error("'" + path + "' is truncated");
+
+        // Undo the filter of every row, in place.
+        for (int y = 0; y < height; ++y) {
+            unsigned char *row = &raw[y * (stride + 1) + 1];
+            const unsigned char *above = y > 0 ? row - (stride + 1) : nullptr;
+            const int filter = row[-1];
+            for (std::size_t i = 0; i < stride; ++i) {
+                const int a = i >= static_cast<std::size_t>(channels) ? row[i - channels] : 0;
+                const int b = above != nullptr ? above[i] : 0;
+                const int c = above != nullptr && i >= static_cast<std::size_t>(channels) ? above[i - channels] : 0;
+                const int predicted = filter == 1 ? a : filter == 2 ? b : filter == 3 ? (a + b) / 2
+                                    : filter == 4 ? Paeth(a, b, c) : 0;
+                row[i] = static_cast<unsigned char>(row[i] + predicted);
+            }
+        }
+
+        SoftwareTexture image {width, height, std::vector<std::uint32_t>(static_cast<std::size_t>(width) * height)};
+        for (int y = 0; y < height; ++y) {
+            const unsigned char *row = &raw[y * (stride + 1) + 1];
+            for (int x = 0; x < width; ++x) {
+                const unsigned char *pixel = row + static_cast<std::size_t>(x) * channels;
+                std::uint32_t r = pixel[0];
+                std::uint32_t g = pixel[0];
+                std::uint32_t b = pixel[0];
+                std::uint32_t alpha = 255;
+                if (colorType == 2 || colorType == 6) {
+                    g = pixel[1];
+                    b = pixel[2];
+                }
+                if (colorType == 4) alpha = pixel[1];
+                if (colorType == 6) alpha = pixel[3];
+                if (colorType == 3) {
+                    const std::size_t index = pixel[0];
+                    if (index * 3 + 2 >= palette.size()) throw std::runtime_error("'" + path + "' has a bad palette");
+                    r = palette[index * 3];
+                    g = palette[index * 3 + 1];
+                    b = palette[index * 3 + 2];
+                    alpha = index < paletteAlpha.size() ? paletteAlpha[index] : 255;
+                }
+                image.pixels[static_cast<std::size_t>(y) * width + x] = r | g << 8 | b << 16 | alpha << 24;
+            }
+        }
+        return image;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        std::fprintf(stderr, "Usage: %s <output> <page width> <page height> [padding] <image.png>...\n", argv[0]);
+        return 1;
+    }
+
+    const std::string output = argv[1];
+    const int pageWidth = std::atoi(argv[2]);
+    const int pageHeight = std::atoi(argv[3]);
+    int first = 4;
+    int padding = 1;
+    if (argc > 5 && std::strspn(argv[4], "0123456789") == std::strlen(argv[4])) {
+        padding = std::atoi(argv[4]);
+        first = 5;
+    }
+
+    try {
+        if (pageWidth <= 0 || pageHeight <= 0) throw std::invalid_argument("The page size must be positive");
+
+        std::vector<SoftwareTexture> images;
+        std::vector<AtlasInput> inputs;
+        for (int i = first; i < argc; ++i) {
+            images.push_back(ReadPng(argv[i]));
+            inputs.push_back({argv[i], images.back().width, images.back().height});
+        }
+
+        AtlasPacker packer {pageWidth, pageHeight, padding};
+        const std::vector<AtlasPlacement> placements = packer.Pack(inputs);
+
+        // Transparent pages, with every image copied to its place.
+        std::vector<SoftwareTexture> pages(packer.PageCount(), SoftwareTexture {
+                pageWidth, pageHeight, std::vector<std::uint32_t>(static_cast<std::size_t>(pageWidth) * pageHeight)});
+        for (std::size_t i = 0; i < placements.size(); ++i) {
+            const AtlasPlacement &placement = placements[i];
+            SoftwareTexture &page = pages[placement.page];
+            for (int y = 0; y < placement.height; ++y) {
+                std::copy_n(images[i].pixels.begin() + static_cast<std::ptrdiff_t>(y) * placement.width,
+                            placement.width,
+                            page.pixels.begin() + static_cast<std::ptrdiff_t>(placement.y + y) * pageWidth + placement.x);
+            }
+        }
+
+        std::vector<std::string> pagePaths;
+        for (std::size_t page = 0; page < pages.size(); ++page) {
+            pagePaths.push_back(output + "-" + std::to_string(page) + ".png");
+            WritePng(pagePaths.back(), pages[page]);
+        }
+
+        std::ofstream table {output + ".atlas"};
+        packer.WriteTable(table, pagePaths, placements);
+        if (!table) throw std::runtime_error("Cannot write '" + output + ".atlas'");
+
+        std::printf("%zu images on %zu pages of %dx%d\n", placements.size(), pages.size(), pageWidth, pageHeight);
+    } catch (const std::exception &error) {
+        std::fprintf(stderr, "%s\n", error.what());
+        return 1;
+    }
+    return 0;
+}